@@ -6,15 +6,41 @@
 #include "hardware/pwm.h"
 #include "hardware/pio.h"
 #include "hardware/clocks.h"
+#include "hardware/sync.h"
 #include "lib/ssd1306.h"
+#include "lib/buzzer.h"
+#include "lib/botoes.h"
+#include "lib/joystick.h"
+#include "lib/matriz_led.h"
+#include "lib/animacao.h"
+#include "lib/fila_spsc.h"
+#include "lib/metricas.h"
+#include "lib/credenciais.h"
+#include "lib/auditoria.h"
+#include "lib/ui.h"
+#include "lib/ritmo.h"
+#include "lib/console.h"
+#include "lib/imagens.h"
 #include "pico/bootrom.h"
-#include "lib/ws2812.pio.h"
+#include "pico/multicore.h"
+#include "pico/flash.h"
 
 #define I2C_PORT i2c1
 #define I2C_SDA 14
 #define I2C_SCL 15
 #define DISPLAY_ADDR 0x3C
 
+// Painel interno opcional, com o estado do cofre, no outro barramento I2C. Os dois painéis
+// transmitem ao mesmo tempo; se ficarem no mesmo barramento, precisam de endereços diferentes.
+#ifndef PAINEL_INTERNO
+#define PAINEL_INTERNO 0
+#endif
+#define I2C_PORT_INTERNO i2c0
+#define I2C_SDA_INTERNO 8
+#define I2C_SCL_INTERNO 9
+#define DISPLAY_ADDR_INTERNO 0x3C
+#define LINHAS_INTERNO 3 // Linhas de texto do painel interno
+
 #define JOYSTICK_X_PIN 27
 #define JOYSTICK_Y_PIN 26
 #define JOYSTICK_PB 22
@@ -25,19 +51,157 @@
 #define LED_RED 13
 #define BUZZER_PIN 10
 
-#define SENHA_CORRETA "1234"
+#define TAMANHO_SENHA 4 // As senhas ficam em lib/credenciais_tabela.c, gerada por ferramentas/gerar_credenciais.py
 #define TENTATIVAS_MAX 3
 
 // Configurações da matriz de LEDs WS2812
 #define LED_PIN 7    // Pino de controle dos LEDs WS2812
 #define LED_COUNT 25 // 5x5 = 25 LEDs
 
+// Intervalo fixo de cada iteração do loop principal
+#define TICK_MS 10
+#define QUADROS_POR_SEGUNDO RITMO_FPS_PADRAO // Taxa máxima de quadros dos displays
+#define TICK_DESLIGADO_MS 100 // Com o display desligado; os botões acordam antes, o joystick em até um tick
+#define ENVIO_NS_POR_BIT 2500 // Duração de um bit no I2C a 400 kHz
+#define ENVIO_FOLGA_US 20     // Espera mínima entre consultas a um envio que passou da previsão
+
+// Tempos de cada fase temporizada
+#define TEMPO_COFRE_ABERTO_MS 5000
+#define TEMPO_SENHA_INCORRETA_MS 2000
+#define TEMPO_BLOQUEIO_MS 10000
+#define TEMPO_MENSAGEM_USB_MS 1000
+#define TEMPO_DEBOUNCE_BOTAO_MS 20
+#define TEMPO_OCIOSO_MS 5000 // Sem entradas por este tempo, a flash pode ser apagada sem atrapalhar ninguém
+
+// Economia de energia: sem entradas com o teclado na tela, o display escurece e depois desliga
+#define TEMPO_ESCURECER_MS 15000
+#define TEMPO_DESLIGAR_MS 30000
+#define CONTRASTE_NORMAL 0xFF
+#define CONTRASTE_ESCURECIDO 0x08
+
+// Registros de auditoria impressos ao receber 'a' pela serial/USB
+#define AUDITORIA_IMPRIMIR_MAX 64
+
+// Estados do sistema
+typedef enum
+{
+    ESTADO_OCIOSO,     // Teclado exibido, nenhum dígito digitado
+    ESTADO_DIGITANDO,  // Senha parcialmente digitada
+    ESTADO_LIBERADO,   // Senha correta, cofre aberto
+    ESTADO_NEGADO,     // Senha incorreta
+    ESTADO_BLOQUEADO,  // Tentativas esgotadas
+    ESTADO_BOOTLOADER  // Exibindo aviso antes de entrar no modo USB
+} estado_t;
+
+// Níveis de energia do display e da matriz de LEDs
+typedef enum
+{
+    ENERGIA_NORMAL,
+    ENERGIA_ESCURECIDA, // Display com contraste mínimo
+    ENERGIA_DESLIGADA   // Display desligado (a GDDRAM é preservada) e matriz apagada
+} energia_t;
+
+// Comandos enviados pelo núcleo 0 (entrada e lógica) ao núcleo 1 (display, matriz e buzzer)
+typedef enum
+{
+    COMANDO_TECLADO,         // Exibe o teclado com o cursor em (cursor_x, cursor_y)
+    COMANDO_MENSAGEM,        // Exibe 'texto' no display e limpa a barra de status e a imagem
+    COMANDO_IMAGEM,          // Exibe a imagem apontada por 'dados' abaixo da mensagem atual
+    COMANDO_STATUS,          // Exibe 'texto' na barra de status da tela de mensagem
+    COMANDO_ANIMACAO,        // Toca a animação apontada por 'dados'
+    COMANDO_PARAR_ANIMACAO,  // Apaga a matriz de LEDs
+    COMANDO_MELODIA,         // Toca 'quantidade' eventos de buzzer apontados por 'dados'
+    COMANDO_ENERGIA,         // Muda o display e a matriz para o nível 'quantidade' (energia_t)
+    COMANDO_INTERNO,         // Exibe 'texto' na linha cursor_y do painel interno
+    COMANDO_CONSOLE,         // Mostra (quantidade = 1) ou esconde o console de diagnóstico
+    COMANDO_ZERAR_METRICAS   // Zera os histogramas e a trilha de eventos do núcleo 1
+} comando_tipo_t;
+
+typedef struct
+{
+    comando_tipo_t tipo;
+    uint8_t cursor_x, cursor_y;
+    char texto[24];
+    const void *dados; // Sempre aponta para dados constantes, que não mudam depois do envio
+    size_t quantidade;
+    uint32_t origem_us; // Instante do botão que originou o comando (0 = nenhum)
+} comando_t;
+
+#define FILA_COMANDOS_TAMANHO 16 // Potência de 2
+
+// Tipos de evento da trilha de métricas
+typedef enum
+{
+    EVENTO_BOTAO,        // Argumento: pino
+    EVENTO_ESTADO,       // Argumento: novo estado
+    EVENTO_ACESSO,       // Argumento: usuário que digitou a senha
+    EVENTO_COMANDO,      // Argumento: tipo do comando executado no núcleo 1
+    EVENTO_ENVIO_INICIO, // Argumento: palavras enviadas ao I2C
+    EVENTO_ENVIO_FIM     // Argumento: painel (0 = externo, 1 = interno)
+} evento_t;
+
+const char *const nomes_eventos[] = {"botao", "estado", "acesso", "comando", "envio_inicio", "envio_fim"};
+
+// Telas do display (núcleo 1)
+typedef enum
+{
+    TELA_NENHUMA,
+    TELA_TECLADO,  // Teclado numérico com o cursor
+    TELA_MENSAGEM, // Mensagem no alto e barra de status no rodapé
+    TELA_CONSOLE   // Linhas de diagnóstico, rolando por hardware
+} tela_t;
+
+#define BARRA_STATUS_Y 54 // Linha do traço separador; o texto fica nas 8 linhas de baixo
+#define IMAGEM_X 48       // Ícone de 32x32 da tela de mensagem, centralizado entre o texto e a barra
+#define IMAGEM_Y 16
+
 // Variáveis globais
-ssd1306_t ssd;
-char senha_digitada[5] = "";
+ssd1306_t ssd; // Painel externo (teclado); usado apenas pelo núcleo 1
+#if PAINEL_INTERNO
+ssd1306_t ssd_interno; // Usado apenas pelo núcleo 1
+ui_rotulo_t ui_interno[LINHAS_INTERNO];
+#endif
+ssd1306_scheduler_t agendador; // Envios aos painéis, sem que um espere pelo outro
+ritmo_t ritmo; // Núcleo 1: quadros dos displays na taxa alvo
+console_t console; // Escrito pelo núcleo 0, desenhado pelo núcleo 1
+bool modo_console = false; // Núcleo 1: o console cobre as outras telas
+tela_t tela_atual = TELA_NENHUMA;    // Núcleo 1: tela pedida pelos comandos
+tela_t tela_desenhada = TELA_NENHUMA; // Núcleo 1: tela que está no framebuffer
+ui_teclado_t ui_teclado;
+ui_rotulo_t ui_mensagem;
+ui_barra_t ui_status;
+ui_imagem_t ui_icone;
+comando_t comandos[FILA_COMANDOS_TAMANHO];
+fila_spsc_t fila_comandos;
+uint32_t instante_entrada_us = 0; // Instante do botão sendo tratado (0 = nenhum)
+
+// Métricas lidas pela serial/USB (veja atender_serial)
+uint32_t eventos_botoes = 0;
+uint32_t tentativas_falhas = 0;
+metricas_histograma_t histograma_iteracao; // Duração de cada iteração do loop principal
+metricas_histograma_t histograma_envio;    // Duração de cada envio ao display
+metricas_histograma_t histograma_latencia; // Do botão pressionado até a tela atualizada
+metricas_histograma_t histograma_despertar; // Da entrada que acordou o sistema até o display religado
+uint32_t tempo_ativo_ms = 0;   // Tempo com o display ligado
+uint32_t tempo_ocioso_ms = 0;  // Tempo com o display desligado, em sono de baixo consumo
+estado_t estado = ESTADO_OCIOSO;
+uint32_t fim_estado = 0; // Momento em que a fase temporizada atual termina
+uint8_t indice_senha = 0;
+const uint pinos_botoes[] = {BUTTON_A, BUTTON_B, JOYSTICK_PB};
+char senha_digitada[TAMANHO_SENHA + 1] = "";
 uint8_t tentativas = 0;
+uint32_t usuario_liberado = 0; // Dono da última senha aceita
+uint32_t ultima_entrada = 0;   // Momento do último botão ou movimento do cursor
+auditoria_meio_t meio_auditoria;
 bool cofre_aberto = false;
-int border_size = 2;
+bool teclado_exibido = false;  // O último pedido ao display foi o teclado
+uint32_t segundos_exibidos = 0; // Contagem do bloqueio na barra de status
+energia_t energia = ENERGIA_NORMAL;
+bool console_exibido = false; // O console de diagnóstico foi pedido pela serial/USB
+uint32_t instante_despertar_us = 0; // Botão que acordou o sistema (0 = nenhum)
+
+const char *const nomes_estados[] = {"ocioso", "digitando", "liberado", "negado", "bloqueado", "modo USB"};
+const char *const nomes_energia[] = {"normal", "escurecida", "desligada"};
 
 // Posição do cursor no teclado numérico
 uint8_t cursor_x = 0;
@@ -50,365 +214,900 @@ const char teclado[4][3] = {
     {'7', '8', '9'},
     {'*', '0', '#'}};
 
-// Frequências das notas musicais (em Hz)
-#define NOTA_C5 523 // Dó5
-#define NOTA_E5 659 // Mi5
-#define NOTA_G5 784 // Sol5
-#define NOTA_A5 880 // Lá5
+// Melodias (frequência, duração, pausa) tocadas em segundo plano pelo buzzer
+const buzzer_evento_t melodia_sucesso[] = {
+    {NOTA_C5, 200, 50}, {NOTA_E5, 200, 50}, {NOTA_G5, 200, 50}, {NOTA_A5, 400, 0}};
+const buzzer_evento_t melodia_erro[] = {
+    {NOTA_C5, 200, 50}, {NOTA_C5, 200, 0}};
+
+// Animações da matriz de LEDs: {linhas do ícone 5x5, r, g, b, interpolar, duração em ms}
+#define ICONE_VAZIO {0x00, 0x00, 0x00, 0x00, 0x00}
+#define ICONE_OK {0x00, 0x01, 0x02, 0x14, 0x08}
+#define ICONE_X {0x11, 0x0A, 0x04, 0x0A, 0x11}
+
+// Dígitos de 3x5 centralizados na matriz, usados na contagem do bloqueio
+#define DIGITO_0 {0x0E, 0x0A, 0x0A, 0x0A, 0x0E}
+#define DIGITO_1 {0x04, 0x0C, 0x04, 0x04, 0x0E}
+#define DIGITO_2 {0x0E, 0x02, 0x0E, 0x08, 0x0E}
+#define DIGITO_3 {0x0E, 0x02, 0x0E, 0x02, 0x0E}
+#define DIGITO_4 {0x0A, 0x0A, 0x0E, 0x02, 0x02}
+#define DIGITO_5 {0x0E, 0x08, 0x0E, 0x02, 0x0E}
+#define DIGITO_6 {0x0E, 0x08, 0x0E, 0x0A, 0x0E}
+#define DIGITO_7 {0x0E, 0x02, 0x04, 0x04, 0x04}
+#define DIGITO_8 {0x0E, 0x0A, 0x0E, 0x0A, 0x0E}
+#define DIGITO_9 {0x0E, 0x0A, 0x0E, 0x02, 0x0E}
 
-// Variáveis para debounce
-uint32_t ultima_leitura_joystick = 0;
-uint16_t joystick_x_debounced = 0;
-uint16_t joystick_y_debounced = 0;
+// Acesso liberado: o sinal de OK surge gradualmente e fica aceso
+const animacao_quadro_t quadros_sucesso[] = {
+    {ICONE_VAZIO, 0, 0, 0, true, 300},
+    {ICONE_OK, 0, 255, 0, false, 0}};
+const animacao_t animacao_sucesso = {quadros_sucesso, 2, false};
+
+// Senha incorreta: X vermelho pulsando
+const animacao_quadro_t quadros_erro[] = {
+    {ICONE_X, 255, 0, 0, true, 250},
+    {ICONE_VAZIO, 0, 0, 0, true, 250}};
+const animacao_t animacao_erro = {quadros_erro, 2, true};
+
+// Bloqueio: contagem regressiva de um dígito por segundo
+const animacao_quadro_t quadros_contagem[] = {
+    {DIGITO_9, 255, 0, 0, false, 1000}, {DIGITO_8, 255, 0, 0, false, 1000},
+    {DIGITO_7, 255, 0, 0, false, 1000}, {DIGITO_6, 255, 0, 0, false, 1000},
+    {DIGITO_5, 255, 0, 0, false, 1000}, {DIGITO_4, 255, 0, 0, false, 1000},
+    {DIGITO_3, 255, 0, 0, false, 1000}, {DIGITO_2, 255, 0, 0, false, 1000},
+    {DIGITO_1, 255, 0, 0, false, 1000}, {DIGITO_0, 255, 0, 0, false, 0}};
+const animacao_t animacao_contagem = {quadros_contagem, 10, false};
+
+// Modo USB: ponto azul girando
+const animacao_quadro_t quadros_espera[] = {
+    {{0x00, 0x08, 0x00, 0x00, 0x00}, 0, 0, 255, false, 80},
+    {{0x00, 0x04, 0x00, 0x00, 0x00}, 0, 0, 255, false, 80},
+    {{0x00, 0x02, 0x00, 0x00, 0x00}, 0, 0, 255, false, 80},
+    {{0x00, 0x00, 0x02, 0x00, 0x00}, 0, 0, 255, false, 80},
+    {{0x00, 0x00, 0x00, 0x02, 0x00}, 0, 0, 255, false, 80},
+    {{0x00, 0x00, 0x00, 0x04, 0x00}, 0, 0, 255, false, 80},
+    {{0x00, 0x00, 0x00, 0x08, 0x00}, 0, 0, 255, false, 80},
+    {{0x00, 0x00, 0x08, 0x00, 0x00}, 0, 0, 255, false, 80}};
+const animacao_t animacao_espera = {quadros_espera, 8, true};
+
+// Configuração do joystick
+#define JOYSTICK_TAXA_HZ 1000       // Amostras por segundo em cada eixo
+#define JOYSTICK_TAXA_DESLIGADO_HZ JOYSTICK_TAXA_MIN_HZ // Desligado, basta notar o toque que acorda
+#define JOYSTICK_ZONA_MORTA 500     // Desvio do centro ignorado (equivale à antiga faixa 1500-2500)
+#define JOYSTICK_LIMIAR_MOVIMENTO 1000 // Desvio do centro que move o cursor
+
+// Variáveis para a movimentação do cursor
 uint32_t ultima_movimentacao_cursor = 0;
-const uint32_t intervalo_debounce_joystick = 50;
 const uint32_t intervalo_movimentacao_cursor = 200;
 
-// Função para exibir mensagem no display OLED
-void exibir_mensagem(const char *mensagem)
+// Função para enviar um comando ao núcleo 1 sem esperar que ele seja executado
+void enviar_comando(comando_t *comando)
 {
-    ssd1306_fill(&ssd, false);
-    ssd1306_draw_string(&ssd, mensagem, 0, 0);
-    ssd1306_send_data(&ssd);
+    if (!comando->origem_us)
+        comando->origem_us = instante_entrada_us;
+    fila_spsc_inserir(&fila_comandos, comando); // Se a fila estiver cheia o comando é descartado e contado
 }
 
-// Função para desenhar o teclado numérico no display
-void desenhar_teclado()
+// Função para escrever uma linha de diagnóstico no console do display, com o instante em segundos.
+// Não espera: com a fila do console cheia, a linha é descartada.
+void registrar_console(uint32_t tempo_atual, const char *texto)
 {
-    ssd1306_fill(&ssd, false); // Limpa a tela
+    char linha[48]; // console_escrever corta em CONSOLE_COLUNAS
+    snprintf(linha, sizeof(linha), "%lu.%03lu %s", (unsigned long)(tempo_atual / 1000),
+             (unsigned long)(tempo_atual % 1000), texto);
+    console_escrever(&console, linha);
+}
 
-    // Desenha a borda da tela
-    for (int i = 0; i < border_size; i++)
-    {
-        ssd1306_rect(&ssd, i, i, WIDTH - (2 * i), HEIGHT - (2 * i), true, false);
-    }
+// Função para mostrar ou esconder o console de diagnóstico
+void exibir_console(bool exibir)
+{
+    comando_t comando = {.tipo = COMANDO_CONSOLE, .quantidade = exibir};
+    enviar_comando(&comando);
+    console_exibido = exibir;
+}
 
-    // Desenha os números do teclado
-    for (uint8_t i = 0; i < 4; i++)
-    {
-        for (uint8_t j = 0; j < 3; j++)
-        {
-            uint8_t x = j * 42; // Posição X do número
-            uint8_t y = i * 16; // Posição Y do número
+// Função para zerar as métricas: cada núcleo zera os histogramas e a trilha que alimenta
+void zerar_metricas()
+{
+    metricas_zerar();
+    comando_t comando = {.tipo = COMANDO_ZERAR_METRICAS};
+    enviar_comando(&comando);
+}
 
-            // Desenha o número
-            ssd1306_draw_char(&ssd, teclado[i][j], x + 10, y + 5);
+// Função para exibir mensagem no display OLED
+void exibir_mensagem(const char *mensagem)
+{
+    comando_t comando = {.tipo = COMANDO_MENSAGEM};
+    snprintf(comando.texto, sizeof(comando.texto), "%s", mensagem);
+    enviar_comando(&comando);
+    teclado_exibido = false;
+}
 
-            // Desenha um retângulo ao redor do número selecionado
-            if (i == cursor_y && j == cursor_x)
-            {
-                ssd1306_rect(&ssd, x, y, 40, 15, true, false);
-            }
-        }
-    }
+// Função para exibir um texto na barra de status, abaixo da mensagem atual
+void exibir_status(const char *texto)
+{
+    comando_t comando = {.tipo = COMANDO_STATUS};
+    snprintf(comando.texto, sizeof(comando.texto), "%s", texto);
+    enviar_comando(&comando);
+}
 
-    ssd1306_send_data(&ssd); // Envia os dados para o display
+// Função para exibir um texto numa linha do painel interno
+void exibir_interno(uint8_t linha, const char *texto)
+{
+    if (!PAINEL_INTERNO)
+        return;
+    comando_t comando = {.tipo = COMANDO_INTERNO, .cursor_y = linha};
+    snprintf(comando.texto, sizeof(comando.texto), "%s", texto);
+    enviar_comando(&comando);
 }
 
-// Função para definir a cor de todos os LEDs da matriz com 50% de intensidade
-void set_led_matrix_color(uint32_t color)
+// Função para exibir uma imagem abaixo da mensagem atual
+void exibir_imagem(const ssd1306_image_t *imagem)
 {
-    // Aplica 50% de intensidade a cada canal de cor
-    uint8_t red = (color >> 16) & 0xFF;  // Extrai o canal vermelho
-    uint8_t green = (color >> 8) & 0xFF; // Extrai o canal verde
+    comando_t comando = {.tipo = COMANDO_IMAGEM, .dados = imagem};
+    enviar_comando(&comando);
+}
 
-    red = red / 2;     // 50% de intensidade para o vermelho
-    green = green / 2; // 50% de intensidade para o verde
+// Função para desenhar o teclado numérico no display
+void desenhar_teclado()
+{
+    comando_t comando = {.tipo = COMANDO_TECLADO, .cursor_x = cursor_x, .cursor_y = cursor_y};
+    enviar_comando(&comando);
+    teclado_exibido = true;
+}
 
-    // Converte a cor para o formato GRB
-    uint32_t grb_color = (green << 16) | (red << 8);
+// Função para tocar uma animação na matriz de LEDs
+void tocar_animacao(const animacao_t *animacao)
+{
+    comando_t comando = {.tipo = COMANDO_ANIMACAO, .dados = animacao};
+    enviar_comando(&comando);
+}
 
-    // Envia a cor para todos os LEDs
-    for (int i = 0; i < LED_COUNT; i++)
-    {
-        pio_sm_put_blocking(pio0, 0, grb_color << 8u);
-    }
+// Função para apagar a matriz de LEDs
+void parar_animacao()
+{
+    comando_t comando = {.tipo = COMANDO_PARAR_ANIMACAO};
+    enviar_comando(&comando);
 }
 
-// Função para ler o joystick com debounce
-void ler_joystick_com_debounce()
+// Função para tocar uma sequência de eventos no buzzer
+void tocar_melodia(const buzzer_evento_t *eventos, size_t quantidade)
 {
-    uint32_t tempo_atual = to_ms_since_boot(get_absolute_time());
+    comando_t comando = {.tipo = COMANDO_MELODIA, .dados = eventos, .quantidade = quantidade};
+    enviar_comando(&comando);
+}
 
-    // Verifica se o intervalo de debounce já passou
-    if (tempo_atual - ultima_leitura_joystick >= intervalo_debounce_joystick)
-    {
-        // Lê os valores do joystick
-        adc_select_input(1); // Seleciona o canal do eixo Y (agora X)
-        uint16_t adc_x = adc_read();
-        adc_select_input(0); // Seleciona o canal do eixo X (agora Y)
-        uint16_t adc_y = adc_read();
-
-        // Aplica uma zona morta para evitar movimentos indesejados
-        if (adc_x < 1500 || adc_x > 2500) // Zona morta no eixo X
-        {
-            joystick_x_debounced = adc_x;
-        }
-        else
-        {
-            joystick_x_debounced = 2048; // Valor central (nenhum movimento)
-        }
+// Função para mudar o nível de energia do display e da matriz de LEDs
+void definir_energia(energia_t nova, uint32_t origem_us)
+{
+    comando_t comando = {.tipo = COMANDO_ENERGIA, .quantidade = nova, .origem_us = origem_us};
+    enviar_comando(&comando);
 
-        if (adc_y < 1500 || adc_y > 2500) // Zona morta no eixo Y
-        {
-            joystick_y_debounced = adc_y;
-        }
-        else
-        {
-            joystick_y_debounced = 2048; // Valor central (nenhum movimento)
-        }
+    // Desligado, o joystick é amostrado devagar; a taxa normal volta ao acordar
+    if ((nova == ENERGIA_DESLIGADA) != (energia == ENERGIA_DESLIGADA))
+        joystick_definir_taxa(nova == ENERGIA_DESLIGADA ? JOYSTICK_TAXA_DESLIGADO_HZ : JOYSTICK_TAXA_HZ);
+    energia = nova;
 
-        // Atualiza o tempo da última leitura
-        ultima_leitura_joystick = tempo_atual;
-    }
+    char linha[24];
+    snprintf(linha, sizeof(linha), "Energia: %s", nomes_energia[nova]);
+    registrar_console(to_ms_since_boot(get_absolute_time()), linha);
 }
 
 // Função para mover o cursor com base no joystick
-void mover_cursor()
+void mover_cursor(uint32_t tempo_atual)
 {
-    uint32_t tempo_atual = to_ms_since_boot(get_absolute_time());
-
     // Verifica se o intervalo mínimo entre movimentos já passou
     if (tempo_atual - ultima_movimentacao_cursor >= intervalo_movimentacao_cursor)
     {
-        // Usa os valores do joystick com debounce
-        uint16_t adc_x = joystick_x_debounced;
-        uint16_t adc_y = joystick_y_debounced;
+        uint8_t anterior_x = cursor_x, anterior_y = cursor_y;
+
+        // Última leitura filtrada do joystick (deslocamento em relação ao centro)
+        int16_t desvio_x, desvio_y;
+        joystick_ler(&desvio_x, &desvio_y);
 
         // Movimento para a esquerda (eixo X)
-        if (adc_x < 1000 && cursor_x > 0)
+        if (desvio_x < -JOYSTICK_LIMIAR_MOVIMENTO && cursor_x > 0)
         {
             cursor_x--;
             ultima_movimentacao_cursor = tempo_atual; // Atualiza o tempo da última movimentação
         }
         // Movimento para a direita (eixo X)
-        else if (adc_x > 3000 && cursor_x < 2)
+        else if (desvio_x > JOYSTICK_LIMIAR_MOVIMENTO && cursor_x < 2)
         {
             cursor_x++;
             ultima_movimentacao_cursor = tempo_atual; // Atualiza o tempo da última movimentação
         }
 
         // Movimento para cima (eixo Y) - Agora invertido
-        if (adc_y > 3000 && cursor_y > 0)
+        if (desvio_y > JOYSTICK_LIMIAR_MOVIMENTO && cursor_y > 0)
         {
             cursor_y--;
             ultima_movimentacao_cursor = tempo_atual; // Atualiza o tempo da última movimentação
         }
         // Movimento para baixo (eixo Y) - Agora invertido
-        else if (adc_y < 1000 && cursor_y < 3)
+        else if (desvio_y < -JOYSTICK_LIMIAR_MOVIMENTO && cursor_y < 3)
         {
             cursor_y++;
             ultima_movimentacao_cursor = tempo_atual; // Atualiza o tempo da última movimentação
         }
 
-        // Atualiza o teclado no display
+        // Atualiza o teclado no display só se o cursor andou ou se outra tela o cobriu
+        if (cursor_x != anterior_x || cursor_y != anterior_y || !teclado_exibido)
+            desenhar_teclado();
+    }
+}
+
+// Função para verificar a senha na tabela de credenciais
+bool verificar_senha(const char *senha, uint32_t *usuario)
+{
+    if (!credenciais_verificar(&credenciais, senha, usuario))
+        return false;
+
+    metricas_evento(EVENTO_ACESSO, (uint16_t)*usuario);
+    return true;
+}
+
+// Função para tocar uma melodia de sucesso (senha correta)
+void tocar_melodia_sucesso()
+{
+    tocar_melodia(melodia_sucesso, sizeof(melodia_sucesso) / sizeof(melodia_sucesso[0]));
+}
+
+// Função para tocar um som de erro (senha incorreta)
+void tocar_som_erro()
+{
+    tocar_melodia(melodia_erro, sizeof(melodia_erro) / sizeof(melodia_erro[0]));
+}
+
+// Função para mostrar na barra de status os segundos que faltam para o fim do bloqueio
+void atualizar_contagem(uint32_t tempo_atual)
+{
+    uint32_t segundos = (fim_estado - tempo_atual + 999) / 1000;
+    if (segundos == segundos_exibidos)
+        return; // Só envia quando o número muda
+
+    char status[24];
+    snprintf(status, sizeof(status), "Aguarde %lu s", (unsigned long)segundos);
+    exibir_status(status);
+    segundos_exibidos = segundos;
+}
+
+// Função para entrar em um novo estado, opcionalmente com duração limitada
+void entrar_estado(estado_t novo, uint32_t duracao_ms, uint32_t tempo_atual)
+{
+    char status[24];
+    estado = novo;
+    fim_estado = tempo_atual + duracao_ms;
+    metricas_evento(EVENTO_ESTADO, novo);
+    snprintf(status, sizeof(status), "Estado: %s", nomes_estados[novo]);
+    registrar_console(tempo_atual, status);
+
+    switch (novo)
+    {
+    case ESTADO_OCIOSO:
+        indice_senha = 0;
+        memset(senha_digitada, 0, sizeof(senha_digitada));
         desenhar_teclado();
+        exibir_interno(0, "Cofre fechado");
+        break;
+
+    case ESTADO_LIBERADO:
+        exibir_mensagem("ACESSO LIBERADO!");
+        snprintf(status, sizeof(status), "Usuario %lu", (unsigned long)usuario_liberado);
+        exibir_status(status);
+        exibir_imagem(&imagem_cadeado_aberto);
+        exibir_interno(0, "Cofre aberto");
+        snprintf(status, sizeof(status), "Ultimo: %lu", (unsigned long)usuario_liberado);
+        exibir_interno(1, status);
+        auditoria_registrar(AUDITORIA_LIBERADO, usuario_liberado, 0, tempo_atual);
+        gpio_put(LED_GREEN, 1);            // Acende o LED verde
+        tocar_animacao(&animacao_sucesso); // Exibe o sinal de OK na matriz de LEDs
+        tocar_melodia_sucesso();
+        cofre_aberto = true;
+        break;
+
+    case ESTADO_NEGADO:
+        tentativas++;
+        tentativas_falhas++;
+        exibir_mensagem("SENHA INCORRETA!");
+        snprintf(status, sizeof(status), "Tentativa %u de %u", tentativas, TENTATIVAS_MAX);
+        exibir_status(status);
+        snprintf(status, sizeof(status), "Falhas: %lu", (unsigned long)tentativas_falhas);
+        exibir_interno(2, status);
+        auditoria_registrar(AUDITORIA_NEGADO, 0, tentativas, tempo_atual);
+        gpio_put(LED_RED, 1);           // Acende o LED vermelho
+        tocar_animacao(&animacao_erro); // Exibe o X pulsando na matriz de LEDs
+        tocar_som_erro();
+        break;
+
+    case ESTADO_BLOQUEADO:
+        exibir_mensagem("BLOQUEADO!");
+        exibir_imagem(&imagem_cadeado_fechado);
+        exibir_interno(0, "Bloqueado");
+        segundos_exibidos = 0;
+        atualizar_contagem(tempo_atual);
+        auditoria_registrar(AUDITORIA_BLOQUEIO, 0, tentativas, tempo_atual);
+        gpio_put(LED_RED, 1);               // Acende o LED vermelho
+        tocar_animacao(&animacao_contagem); // Contagem regressiva do bloqueio na matriz de LEDs
+        break;
+
+    case ESTADO_BOOTLOADER:
+        exibir_mensagem("Entrando no modo USB...");
+        exibir_interno(0, "Modo USB");
+        auditoria_registrar(AUDITORIA_MODO_USB, 0, 0, tempo_atual);
+        tocar_animacao(&animacao_espera); // Ponto girando na matriz de LEDs
+        break;
+
+    default:
+        break;
+    }
+}
+
+// Função chamada quando o tempo de uma fase temporizada se esgota
+void encerrar_fase(uint32_t tempo_atual)
+{
+    switch (estado)
+    {
+    case ESTADO_LIBERADO:
+        gpio_put(LED_GREEN, 0); // Apaga o LED verde
+        parar_animacao();       // Desliga a matriz de LEDs
+        cofre_aberto = false;
+        entrar_estado(ESTADO_OCIOSO, 0, tempo_atual);
+        break;
+
+    case ESTADO_NEGADO:
+        gpio_put(LED_RED, 0); // Apaga o LED vermelho
+        parar_animacao();     // Desliga a matriz de LEDs
+        if (tentativas >= TENTATIVAS_MAX)
+            entrar_estado(ESTADO_BLOQUEADO, TEMPO_BLOQUEIO_MS, tempo_atual);
+        else
+            entrar_estado(ESTADO_OCIOSO, 0, tempo_atual);
+        break;
+
+    case ESTADO_BLOQUEADO:
+        gpio_put(LED_RED, 0); // Apaga o LED vermelho
+        parar_animacao();     // Desliga a matriz de LEDs
+        tentativas = 0;       // Reseta o contador de tentativas
+        entrar_estado(ESTADO_OCIOSO, 0, tempo_atual);
+        break;
+
+    case ESTADO_BOOTLOADER:
+        auditoria_gravar();   // Nada do registro pode ficar só na RAM
+        reset_usb_boot(0, 0); // Entra no modo de bootloader USB
+        break;
+
+    default:
+        break;
+    }
+}
+
+// Função para tratar o pressionamento de um botão enquanto a senha é digitada
+void tratar_botao(uint pino, uint32_t tempo_atual)
+{
+    // Botão A: adiciona o número selecionado à senha
+    if (pino == BUTTON_A)
+    {
+        senha_digitada[indice_senha] = teclado[cursor_y][cursor_x];
+        indice_senha++;
+        estado = ESTADO_DIGITANDO;
+
+        // Exibe a senha digitada no display
+        char mensagem[20];
+        snprintf(mensagem, sizeof(mensagem), "Senha: %s", senha_digitada);
+        exibir_mensagem(mensagem);
+        ultima_movimentacao_cursor = tempo_atual; // O teclado volta depois do intervalo do cursor
+
+        // Verifica se a senha foi completamente digitada
+        if (indice_senha == TAMANHO_SENHA)
+        {
+            if (verificar_senha(senha_digitada, &usuario_liberado))
+                entrar_estado(ESTADO_LIBERADO, TEMPO_COFRE_ABERTO_MS, tempo_atual);
+            else
+                entrar_estado(ESTADO_NEGADO, TEMPO_SENHA_INCORRETA_MS, tempo_atual);
+        }
+    }
+    // Botão B: entra no modo USB
+    else if (pino == BUTTON_B)
+    {
+        entrar_estado(ESTADO_BOOTLOADER, TEMPO_MENSAGEM_USB_MS, tempo_atual);
     }
 }
 
-// Função para verificar a senha
-bool verificar_senha(const char *senha)
+// Função para consumir os eventos gerados pelas interrupções dos botões
+void processar_botoes(uint32_t tempo_atual)
 {
-    return strcmp(senha, SENHA_CORRETA) == 0;
+    botao_evento_t evento;
+    while (botoes_proximo_evento(&evento))
+    {
+        eventos_botoes++;
+        ultima_entrada = tempo_atual;
+        metricas_evento(EVENTO_BOTAO, evento.pino);
+        if (evento.tipo == BOTAO_PRESSIONADO)
+        {
+            char linha[24];
+            snprintf(linha, sizeof(linha), "Botao %u", evento.pino);
+            registrar_console(tempo_atual, linha);
+        }
+
+        // Com o display desligado, o botão só acorda o sistema
+        if (energia == ENERGIA_DESLIGADA)
+        {
+            if (!instante_despertar_us)
+                instante_despertar_us = evento.instante_us;
+            continue;
+        }
+
+        // Nas fases temporizadas os eventos são descartados
+        if (evento.tipo == BOTAO_PRESSIONADO && (estado == ESTADO_OCIOSO || estado == ESTADO_DIGITANDO))
+        {
+            instante_entrada_us = evento.instante_us; // Os comandos gerados levam a origem para medir a latência
+            tratar_botao(evento.pino, tempo_atual);
+            instante_entrada_us = 0;
+        }
+    }
 }
 
-// Função para bloquear o sistema após tentativas falhas
-void bloquear_sistema()
+// Função para indicar se ninguém usa o teclado há algum tempo
+bool sistema_ocioso(uint32_t tempo_atual)
 {
-    exibir_mensagem("BLOQUEADO!");
-    gpio_put(LED_RED, 1);           // Acende o LED vermelho
-    set_led_matrix_color(0xFF0000); // Exibe vermelho na matriz de LEDs
-    sleep_ms(10000);                // Bloqueia por 10 segundos
-    gpio_put(LED_RED, 0);           // Apaga o LED vermelho
-    set_led_matrix_color(0x000000); // Desliga a matriz de LEDs
-    tentativas = 0;                 // Reseta o contador de tentativas
+    return estado == ESTADO_OCIOSO && tempo_atual - ultima_entrada >= TEMPO_OCIOSO_MS &&
+           tempo_atual - ultima_movimentacao_cursor >= TEMPO_OCIOSO_MS;
 }
 
-// Função para tocar uma nota musical no buzzer
-void tocar_nota(uint32_t frequencia, uint32_t duracao_ms)
+// Função para escurecer e depois desligar o display enquanto o teclado fica parado na tela,
+// e religá-lo com qualquer entrada
+void atualizar_energia(uint32_t tempo_atual)
 {
-    // Configura o pino do buzzer para PWM
-    gpio_set_function(BUZZER_PIN, GPIO_FUNC_PWM);
-    uint slice_num = pwm_gpio_to_slice_num(BUZZER_PIN);
-    uint channel_num = pwm_gpio_to_channel(BUZZER_PIN);
+    // Com o display apagado, o joystick fora do centro também conta como entrada
+    if (energia != ENERGIA_NORMAL)
+    {
+        int16_t desvio_x, desvio_y;
+        joystick_ler(&desvio_x, &desvio_y);
+        if (abs(desvio_x) > JOYSTICK_LIMIAR_MOVIMENTO || abs(desvio_y) > JOYSTICK_LIMIAR_MOVIMENTO)
+        {
+            ultima_entrada = tempo_atual;
+            if (energia == ENERGIA_DESLIGADA)
+            {
+                ultima_movimentacao_cursor = tempo_atual; // O movimento que acorda não move o cursor
+                if (!instante_despertar_us)
+                    instante_despertar_us = time_us_32();
+            }
+        }
+    }
 
-    // Configura a frequência do PWM
-    uint32_t clock = 125000000; // Clock do Raspberry Pi Pico (125 MHz)
-    uint32_t divisor = 16;      // Divisor para reduzir a frequência
-    uint32_t wrap = clock / (divisor * frequencia) - 1;
+    uint32_t inativo = tempo_atual - ultima_entrada;
+    if (tempo_atual - ultima_movimentacao_cursor < inativo)
+        inativo = tempo_atual - ultima_movimentacao_cursor;
 
-    pwm_set_clkdiv(slice_num, divisor);
-    pwm_set_wrap(slice_num, wrap);
-    pwm_set_chan_level(slice_num, channel_num, wrap / 2); // 50% de duty cycle
-    pwm_set_enabled(slice_num, true);
+    // O console de diagnóstico fica aceso enquanto estiver na tela
+    energia_t nova = ENERGIA_NORMAL;
+    if (estado == ESTADO_OCIOSO && !console_exibido && inativo >= TEMPO_DESLIGAR_MS)
+        nova = ENERGIA_DESLIGADA;
+    else if (estado == ESTADO_OCIOSO && !console_exibido && inativo >= TEMPO_ESCURECER_MS)
+        nova = ENERGIA_ESCURECIDA;
 
-    // Mantém a nota tocando pelo tempo especificado
-    sleep_ms(duracao_ms);
+    if (nova != energia)
+    {
+        definir_energia(nova, nova == ENERGIA_NORMAL ? instante_despertar_us : 0);
+        instante_despertar_us = 0;
+    }
+}
 
-    // Desliga o PWM
-    pwm_set_enabled(slice_num, false);
+// Função para atender os comandos recebidos pela serial/USB
+void atender_serial()
+{
+    int caractere = getchar_timeout_us(0);
+    if (caractere == 'a')
+        auditoria_imprimir(AUDITORIA_IMPRIMIR_MAX); // Registros de auditoria, do mais novo ao mais antigo
+    else if (caractere == 'c')
+        exibir_console(!console_exibido); // Alterna o console de diagnóstico no display
+    else if (caractere == 'z')
+        zerar_metricas();
+    else if (caractere != PICO_ERROR_TIMEOUT)
+        metricas_atender(caractere);
 }
 
-// Função para tocar uma melodia de sucesso (senha correta)
-void tocar_melodia_sucesso()
+// Função para desenhar a tela atual (núcleo 1). Ao trocar de tela o display é limpo e os
+// widgets da nova tela são redesenhados inteiros; depois, cada widget só redesenha o que mudou.
+void renderizar_tela()
 {
-    tocar_nota(NOTA_C5, 200); // Dó5
-    sleep_ms(50);
-    tocar_nota(NOTA_E5, 200); // Mi5
-    sleep_ms(50);
-    tocar_nota(NOTA_G5, 200); // Sol5
-    sleep_ms(50);
-    tocar_nota(NOTA_A5, 400); // Lá5
+    tela_t tela = modo_console ? TELA_CONSOLE : tela_atual;
+    if (tela != tela_desenhada)
+    {
+        ssd1306_fill(&ssd, false);
+        ssd1306_set_start_line(&ssd, 0); // Só o console rola a tela
+        ui_teclado_invalidar(&ui_teclado);
+        ui_rotulo_invalidar(&ui_mensagem);
+        ui_barra_invalidar(&ui_status);
+        ui_imagem_invalidar(&ui_icone);
+        console_invalidar(&console);
+        tela_desenhada = tela;
+    }
+
+    switch (tela_desenhada)
+    {
+    case TELA_TECLADO:
+        ui_teclado_desenhar(&ui_teclado, &ssd);
+        break;
+
+    case TELA_MENSAGEM:
+        if (ui_rotulo_desenhar(&ui_mensagem, &ssd))
+            ui_imagem_invalidar(&ui_icone); // A área da mensagem inclui a do ícone
+        ui_imagem_desenhar(&ui_icone, &ssd);
+        ui_barra_desenhar(&ui_status, &ssd);
+        break;
+
+    case TELA_CONSOLE:
+        console_desenhar(&console, &ssd);
+        break;
+
+    default:
+        break;
+    }
 }
 
-// Função para tocar um som de erro (senha incorreta)
-void tocar_som_erro()
+// Função para desenhar as linhas do painel interno que mudaram (núcleo 1)
+void renderizar_interno()
+{
+#if PAINEL_INTERNO
+    for (uint8_t i = 0; i < LINHAS_INTERNO; i++)
+        ui_rotulo_desenhar(&ui_interno[i], &ssd_interno);
+#endif
+}
+
+// Função para aplicar um nível de energia aos displays e à matriz de LEDs (núcleo 1)
+void aplicar_energia(energia_t nivel, uint32_t origem_us)
 {
-    tocar_nota(NOTA_C5, 200); // Dó5
-    sleep_ms(50);
-    tocar_nota(NOTA_C5, 200); // Dó5
+    for (uint8_t i = 0; i < agendador.count; i++)
+    {
+        ssd1306_t *painel = agendador.panels[i];
+        switch (nivel)
+        {
+        case ENERGIA_NORMAL:
+            ssd1306_set_contrast(painel, CONTRASTE_NORMAL);
+            ssd1306_display_on(painel, true);
+            break;
+
+        case ENERGIA_ESCURECIDA:
+            ssd1306_set_contrast(painel, CONTRASTE_ESCURECIDO);
+            break;
+
+        case ENERGIA_DESLIGADA:
+            ssd1306_display_on(painel, false); // O conteúdo da tela fica na GDDRAM para a volta
+            break;
+        }
+    }
+
+    if (nivel == ENERGIA_NORMAL && origem_us)
+        metricas_medir(&histograma_despertar, time_us_32() - origem_us);
+    else if (nivel == ENERGIA_DESLIGADA)
+        animacao_parar(); // Apaga a matriz de LEDs; depois disso o temporizador das animações para
 }
 
-// Função para debounce do botão
-bool debounce(uint pin)
+// Função para executar um comando recebido do núcleo 0. Retorna true se ele muda o
+// conteúdo dos displays, que só é desenhado no próximo quadro.
+bool executar_comando(const comando_t *comando)
 {
-    if (!gpio_get(pin)) // Verifica se o botão está pressionado
+    switch (comando->tipo)
+    {
+    case COMANDO_TECLADO:
+        ui_teclado_selecionar(&ui_teclado, comando->cursor_x, comando->cursor_y);
+        tela_atual = TELA_TECLADO;
+        return true;
+
+    case COMANDO_MENSAGEM:
+        ui_rotulo_definir(&ui_mensagem, comando->texto);
+        ui_barra_definir(&ui_status, "");
+        ui_imagem_definir(&ui_icone, NULL);
+        tela_atual = TELA_MENSAGEM;
+        return true;
+
+    case COMANDO_IMAGEM:
+        ui_imagem_definir(&ui_icone, comando->dados);
+        return true;
+
+    case COMANDO_STATUS:
+        ui_barra_definir(&ui_status, comando->texto);
+        return true;
+
+    case COMANDO_ANIMACAO:
+        animacao_tocar(comando->dados);
+        break;
+
+    case COMANDO_PARAR_ANIMACAO:
+        animacao_parar();
+        break;
+
+    case COMANDO_MELODIA:
+        buzzer_tocar(comando->dados, comando->quantidade);
+        break;
+
+    case COMANDO_ENERGIA:
+        aplicar_energia((energia_t)comando->quantidade, comando->origem_us);
+        break;
+
+    case COMANDO_INTERNO:
+#if PAINEL_INTERNO
+        if (comando->cursor_y < LINHAS_INTERNO)
+            ui_rotulo_definir(&ui_interno[comando->cursor_y], comando->texto);
+#endif
+        return true;
+
+    case COMANDO_CONSOLE:
+        modo_console = comando->quantidade;
+        return true;
+
+    case COMANDO_ZERAR_METRICAS:
+        metricas_zerar();
+        break;
+    }
+    return false;
+}
+
+// Ponto de entrada do núcleo 1: display, matriz de LEDs e buzzer
+void core1_main()
+{
+    // Permite que o núcleo 0 pause este núcleo enquanto apaga ou grava a flash
+    flash_safe_execute_core_init();
+
+    // Os alarmes do buzzer e o temporizador das animações usam um pool criado aqui,
+    // para que seus callbacks rodem neste núcleo e não atrasem a leitura das entradas
+    alarm_pool_t *pool = alarm_pool_create_with_unused_hardware_alarm(8);
+
+    ssd1306_init(&ssd, WIDTH, HEIGHT, false, DISPLAY_ADDR, I2C_PORT);
+    ssd1306_config(&ssd);
+    ssd1306_fill(&ssd, false);
+    ssd1306_send_data(&ssd);
+
+    // Widgets das telas: teclado em tela cheia; mensagem acima da barra de status
+    ui_teclado_init(&ui_teclado, &teclado[0][0], 3, 4);
+    ui_rotulo_init(&ui_mensagem, 0, 0, WIDTH, BARRA_STATUS_Y);
+    ui_barra_init(&ui_status, BARRA_STATUS_Y);
+    ui_imagem_init(&ui_icone, IMAGEM_X, IMAGEM_Y);
+
+    ssd1306_scheduler_init(&agendador);
+    ssd1306_scheduler_add(&agendador, &ssd); // Painel 0: externo
+#if PAINEL_INTERNO
+    ssd1306_init(&ssd_interno, WIDTH, HEIGHT, false, DISPLAY_ADDR_INTERNO, I2C_PORT_INTERNO);
+    ssd1306_config(&ssd_interno);
+    ssd1306_fill(&ssd_interno, false);
+    for (uint8_t i = 0; i < LINHAS_INTERNO; i++)
+        ui_rotulo_init(&ui_interno[i], 0, i * 16, WIDTH, 16);
+    ssd1306_scheduler_add(&agendador, &ssd_interno); // Painel 1: interno
+#endif
+
+    buzzer_init(BUZZER_PIN, pool);
+
+    // Inicialização da matriz de LEDs WS2812
+    matriz_init(pio0, 0, LED_PIN);
+    animacao_init(ANIMACAO_FPS_PADRAO, pool); // Animações avançam por temporizador
+
+    ritmo_init(&ritmo, QUADROS_POR_SEGUNDO);
+    ritmo_marcar(&ritmo); // Primeiro quadro: a tela limpa e o painel interno
+
+    uint32_t inicio_envio_us[SSD1306_SCHEDULER_MAX] = {0};
+    uint32_t origem_pendente_us = 0; // Botão mais antigo já desenhado no painel externo e ainda não enviado
+    uint32_t origem_envio_us = 0;    // Botão mais antigo incluído no envio em andamento ao painel externo
+    while (true)
     {
-        sleep_ms(50);       // Aguarda 50ms para estabilizar o sinal
-        if (!gpio_get(pin)) // Verifica novamente
+        comando_t comando;
+        while (fila_spsc_retirar(&fila_comandos, &comando))
+        {
+            metricas_evento(EVENTO_COMANDO, comando.tipo);
+            if (executar_comando(&comando))
+            {
+                ritmo_marcar(&ritmo);
+                if (comando.origem_us && !origem_pendente_us)
+                    origem_pendente_us = comando.origem_us;
+            }
+        }
+        if (console_receber(&console) && modo_console)
+            ritmo_marcar(&ritmo); // Linhas novas do console saem no próximo quadro
+
+        // Os comandos recebidos desde o último quadro resultam num único desenho, na janela
+        // do próximo quadro e depois que o anterior terminou de ser enviado
+        if (!agendador.flushing && ritmo_iniciar_quadro(&ritmo, time_us_32()))
+        {
+            renderizar_tela();
+            renderizar_interno();
+
+            // Se o painel externo não mudou, os botões pendentes não tiveram efeito na tela
+            if (!ssd1306_has_changes(&ssd))
+                origem_pendente_us = 0;
+        }
+
+        // Envia a cada painel o que mudou, cada um no seu ritmo; comandos que chegarem durante
+        // o DMA de um painel entram no próximo envio dele
+        uint32_t iniciados;
+        uint32_t concluidos = ssd1306_scheduler_poll(&agendador, &iniciados);
+        uint32_t agora_us = time_us_32();
+        for (uint8_t i = 0; i < agendador.count; i++)
         {
-            return true; // Botão pressionado
+            uint32_t bit = 1u << i;
+            if (concluidos & bit)
+            {
+                metricas_medir(&histograma_envio, agora_us - inicio_envio_us[i]);
+                if (i == 0 && origem_envio_us)
+                    metricas_medir(&histograma_latencia, agora_us - origem_envio_us);
+                metricas_evento(EVENTO_ENVIO_FIM, i);
+            }
+            if (iniciados & bit)
+            {
+                inicio_envio_us[i] = agora_us;
+                metricas_evento(EVENTO_ENVIO_INICIO, agendador.panels[i]->tx_len);
+                if (i == 0)
+                {
+                    origem_envio_us = origem_pendente_us;
+                    origem_pendente_us = 0;
+                }
+            }
         }
+        if (!agendador.flushing)
+            ritmo_quadro_exibido(&ritmo, agora_us);
+        if (concluidos)
+            continue; // Um quadro pendente pode começar em seguida
+
+        // Com um envio em andamento, dorme até a previsão de fim do primeiro a terminar (pelos
+        // bits do fluxo) ou até um novo comando, em vez de consultar o DMA sem parar
+        if (agendador.flushing)
+        {
+            int32_t espera_envio_us = INT32_MAX;
+            for (uint8_t i = 0; i < agendador.count; i++)
+            {
+                if (!(agendador.flushing & (1u << i)))
+                    continue;
+                uint32_t duracao_us = (ssd1306_flush_bits(agendador.panels[i]) * ENVIO_NS_POR_BIT + 999) / 1000;
+                int32_t restante_us = (int32_t)(inicio_envio_us[i] + duracao_us - agora_us);
+                if (restante_us < espera_envio_us)
+                    espera_envio_us = restante_us;
+            }
+            if (espera_envio_us < ENVIO_FOLGA_US)
+                espera_envio_us = ENVIO_FOLGA_US;
+            best_effort_wfe_or_timeout(make_timeout_time_us(espera_envio_us));
+            continue;
+        }
+
+        // Com os displays ociosos, dorme até um novo comando (__sev do núcleo 0), uma
+        // interrupção ou a janela do quadro pendente
+        uint32_t espera_us;
+        if (!ritmo_espera_us(&ritmo, agora_us, &espera_us))
+            __wfe();
+        else if (espera_us)
+            best_effort_wfe_or_timeout(make_timeout_time_us(espera_us));
     }
-    return false; // Botão não pressionado
 }
 
 int main()
 {
     stdio_init_all();
 
+    // Métricas: contadores, histogramas e trilha de eventos, impressos ao receber 'm' pela serial/USB
+    metricas_init(nomes_eventos, sizeof(nomes_eventos) / sizeof(nomes_eventos[0]));
+    metricas_contador("i2c_bytes", &ssd.bytes_sent);
+    metricas_contador("quadros_enviados", &ssd.frames_sent);
+    metricas_contador("erros_i2c", &ssd.tx_errors);
+    metricas_contador("eventos_botoes", &eventos_botoes);
+    metricas_contador("eventos_botoes_perdidos", &botoes_eventos_perdidos);
+    metricas_contador("tentativas_falhas", &tentativas_falhas);
+    metricas_contador("comandos_descartados", &fila_comandos.descartados);
+    metricas_contador("console_descartadas", &console.fila.descartados);
+    metricas_contador("cache_textos_acertos", &ssd1306_text_cache_stats.hits);
+    metricas_contador("cache_textos_falhas", &ssd1306_text_cache_stats.misses);
+    metricas_histograma(&histograma_iteracao, "iteracao_us", 0);
+    metricas_histograma(&histograma_envio, "envio_display_us", 1);
+    metricas_histograma(&histograma_latencia, "botao_ate_tela_us", 1);
+    metricas_histograma(&histograma_despertar, "despertar_us", 1);
+    metricas_histograma(&ritmo.tempos, "quadro_us", 1);
+    metricas_contador("quadros_exibidos", &ritmo.quadros);
+    metricas_contador("quadros_atrasados", &ritmo.atrasados);
+    metricas_contador("animacao_atrasados", &animacao_estatisticas.atrasados);
+    metricas_contador("animacao_descartados", &animacao_estatisticas.descartados);
+    metricas_contador("tempo_ativo_ms", &tempo_ativo_ms);
+    metricas_contador("tempo_ocioso_ms", &tempo_ocioso_ms);
+
+    // Registro de auditoria: reencontra o fim do que já está na flash e marca a inicialização
+    auditoria_meio_flash(&meio_auditoria);
+    auditoria_init(&meio_auditoria);
+    auditoria_registrar(AUDITORIA_INICIO, 0, 0, to_ms_since_boot(get_absolute_time()));
+    metricas_contador("auditoria_registros", &auditoria_estatisticas.registros);
+    metricas_contador("auditoria_paginas", &auditoria_estatisticas.paginas_gravadas);
+    metricas_contador("auditoria_apagamentos", &auditoria_estatisticas.setores_apagados);
+    metricas_contador("auditoria_falhas", &auditoria_estatisticas.falhas);
+
     // Inicialização do I2C e display OLED
     i2c_init(I2C_PORT, 400 * 1000);
     gpio_set_function(I2C_SDA, GPIO_FUNC_I2C);
     gpio_set_function(I2C_SCL, GPIO_FUNC_I2C);
     gpio_pull_up(I2C_SDA);
     gpio_pull_up(I2C_SCL);
+#if PAINEL_INTERNO
+    i2c_init(I2C_PORT_INTERNO, 400 * 1000);
+    gpio_set_function(I2C_SDA_INTERNO, GPIO_FUNC_I2C);
+    gpio_set_function(I2C_SCL_INTERNO, GPIO_FUNC_I2C);
+    gpio_pull_up(I2C_SDA_INTERNO);
+    gpio_pull_up(I2C_SCL_INTERNO);
+#endif
 
-    ssd1306_init(&ssd, WIDTH, HEIGHT, false, DISPLAY_ADDR, I2C_PORT);
-    ssd1306_config(&ssd);
-    ssd1306_fill(&ssd, false);
-    ssd1306_send_data(&ssd);
+    // Display, matriz de LEDs e buzzer ficam no núcleo 1, alimentado pela fila de comandos
+    fila_spsc_init(&fila_comandos, comandos, sizeof(comandos[0]), FILA_COMANDOS_TAMANHO);
+    console_init(&console, HEIGHT / 8);
+    multicore_launch_core1(core1_main);
 
-    // Inicialização do ADC para o joystick
-    adc_init();
-    adc_gpio_init(JOYSTICK_X_PIN);
-    adc_gpio_init(JOYSTICK_Y_PIN);
+    // Inicialização do joystick: ADC em round-robin com as amostras gravadas por DMA
+    joystick_init(JOYSTICK_X_PIN, JOYSTICK_Y_PIN, JOYSTICK_TAXA_HZ);
+    joystick_configurar_filtro(JOYSTICK_FILTRO_MEDIANA, 5, 0);
+    joystick_calibrar(JOYSTICK_ZONA_MORTA, JOYSTICK_ZONA_MORTA);
 
     // Inicialização dos GPIOs
-    gpio_init(JOYSTICK_PB);
-    gpio_set_dir(JOYSTICK_PB, GPIO_IN);
-    gpio_pull_up(JOYSTICK_PB);
-
     gpio_init(LED_GREEN);
     gpio_set_dir(LED_GREEN, GPIO_OUT);
     gpio_init(LED_RED);
     gpio_set_dir(LED_RED, GPIO_OUT);
 
-    gpio_init(BUTTON_A);
-    gpio_set_dir(BUTTON_A, GPIO_IN);
-    gpio_pull_up(BUTTON_A);
-
-    gpio_init(BUTTON_B); // Inicializa o botão B
-    gpio_set_dir(BUTTON_B, GPIO_IN);
-    gpio_pull_up(BUTTON_B);
-
-    gpio_init(BUZZER_PIN);
-    gpio_set_dir(BUZZER_PIN, GPIO_OUT);
-
-    // Inicialização da matriz de LEDs WS2812
-    PIO pio = pio0;
-    uint offset = pio_add_program(pio, &ws2812_program);
-    ws2812_program_init(pio, 0, offset, LED_PIN, 800000, false);
+    // Botões A, B e do joystick: interrupções de borda com debounce por tempo
+    botoes_init(pinos_botoes, sizeof(pinos_botoes) / sizeof(pinos_botoes[0]), TEMPO_DEBOUNCE_BOTAO_MS * 1000);
 
     // Exibe o teclado no display
-    desenhar_teclado();
+    entrar_estado(ESTADO_OCIOSO, 0, to_ms_since_boot(get_absolute_time()));
 
-    // Loop principal
-    uint8_t indice_senha = 0;
+    // Loop principal: uma iteração a cada TICK_MS; desenho e som não bloqueiam este núcleo
+    absolute_time_t proximo_tick = get_absolute_time();
+    uint32_t tempo_anterior = to_ms_since_boot(proximo_tick);
     while (true)
     {
-        // Lê o joystick com debounce
-        ler_joystick_com_debounce();
+        uint32_t inicio_iteracao_us = time_us_32();
+        uint32_t tempo_atual = to_ms_since_boot(get_absolute_time());
 
-        // Move o cursor com o joystick
-        mover_cursor();
+        // O intervalo desde a iteração anterior conta no nível de energia em que ela terminou
+        if (energia == ENERGIA_DESLIGADA)
+            tempo_ocioso_ms += tempo_atual - tempo_anterior;
+        else
+            tempo_ativo_ms += tempo_atual - tempo_anterior;
+        tempo_anterior = tempo_atual;
 
-        // Verifica se o botão A foi pressionado (com debounce)
-        if (debounce(BUTTON_A))
-        {
-            // Adiciona o número selecionado à senha
-            senha_digitada[indice_senha] = teclado[cursor_y][cursor_x];
-            indice_senha++;
+        // Atende pedidos de leitura das métricas e do registro de auditoria
+        atender_serial();
 
-            // Exibe a senha digitada no display
-            char mensagem[20];
-            snprintf(mensagem, sizeof(mensagem), "Senha: %s", senha_digitada);
-            exibir_mensagem(mensagem);
+        // Trata os botões pressionados desde a última iteração
+        processar_botoes(tempo_atual);
 
-            // Aguarda o botão ser solto
-            while (!gpio_get(BUTTON_A))
-            {
-                sleep_ms(10);
-            }
+        // Escurece ou desliga o display sem entradas; qualquer entrada o religa
+        atualizar_energia(tempo_atual);
 
-            // Verifica se a senha foi completamente digitada
-            if (indice_senha == 4)
-            {
-                // Quando a senha estiver correta
-                if (verificar_senha(senha_digitada))
-                {
-                    exibir_mensagem("ACESSO LIBERADO!");
-                    gpio_put(LED_GREEN, 1);         // Acende o LED verde
-                    set_led_matrix_color(0x00FF00); // Exibe verde na matriz de LEDs (corrigido)
-                    tocar_melodia_sucesso();        // Toca a melodia de sucesso
-                    cofre_aberto = true;
-                    sleep_ms(5000);                 // Mantém o cofre aberto por 5 segundos
-                    gpio_put(LED_GREEN, 0);         // Apaga o LED verde
-                    set_led_matrix_color(0x000000); // Desliga a matriz de LEDs
-                    cofre_aberto = false;
-                }
-                else
-                {
-                    tentativas++;
-                    exibir_mensagem("SENHA INCORRETA!");
-                    gpio_put(LED_RED, 1);           // Acende o LED vermelho
-                    set_led_matrix_color(0xFF0000); // Exibe vermelho na matriz de LEDs (corrigido)
-                    tocar_som_erro();               // Toca o som de erro
-                    sleep_ms(2000);                 // Mantém o LED vermelho aceso por 2 segundos
-                    gpio_put(LED_RED, 0);           // Apaga o LED vermelho
-                    set_led_matrix_color(0x000000); // Desliga a matriz de LEDs
-
-                    if (tentativas >= TENTATIVAS_MAX)
-                    {
-                        bloquear_sistema();
-                    }
-                }
+        switch (estado)
+        {
+        case ESTADO_OCIOSO:
+        case ESTADO_DIGITANDO:
+            mover_cursor(tempo_atual); // Move o cursor com o joystick
+            break;
 
-                // Reseta a senha digitada
-                indice_senha = 0;
-                memset(senha_digitada, 0, sizeof(senha_digitada));
-                desenhar_teclado();
-            }
+        default:
+            if ((int32_t)(tempo_atual - fim_estado) >= 0)
+                encerrar_fase(tempo_atual);
+            else if (estado == ESTADO_BLOQUEADO)
+                atualizar_contagem(tempo_atual);
+            break;
         }
 
-        // Verifica se o botão B foi pressionado (com debounce)
-        if (debounce(BUTTON_B))
+        // Grava os registros de auditoria em lotes; apagamentos só com o sistema ocioso
+        auditoria_atender(tempo_atual, sistema_ocioso(tempo_atual));
+
+        metricas_medir(&histograma_iteracao, time_us_32() - inicio_iteracao_us);
+
+        // Aguarda o próximo tick. Com o display desligado o tick é mais longo e o núcleo
+        // dorme em __wfe(); a interrupção de um botão o acorda antes do prazo.
+        if (energia == ENERGIA_DESLIGADA)
         {
-            exibir_mensagem("Entrando no modo USB...");
-            sleep_ms(1000);       // Aguarda um pouco para exibir a mensagem
-            reset_usb_boot(0, 0); // Entra no modo de bootloader USB
+            proximo_tick = delayed_by_ms(proximo_tick, TICK_DESLIGADO_MS);
+            while (!botoes_tem_evento() && !best_effort_wfe_or_timeout(proximo_tick))
+                ;
+            if (botoes_tem_evento())
+                proximo_tick = get_absolute_time(); // Atende o botão já
+        }
+        else
+        {
+            proximo_tick = delayed_by_ms(proximo_tick, TICK_MS);
+            sleep_until(proximo_tick);
         }
-
-        sleep_ms(10); // Pequeno atraso para evitar leituras rápidas demais
     }
-}
\ No newline at end of file
+}
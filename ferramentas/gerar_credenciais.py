@@ -0,0 +1,135 @@
+#!/usr/bin/env python3
+"""Gera lib/credenciais_tabela.c a partir de uma lista de usuários e senhas.
+
+Entrada: um arquivo texto com uma credencial por linha, "<usuario>,<senha>"; linhas que
+começam com '#' são comentários ('#' também é uma tecla, então não há comentário no fim
+da linha). O usuário é um número (0 a 4294967295) e a senha usa as teclas do
+teclado do display (0-9, * e #).
+
+Cada senha vira o SipHash-2-4 dela com uma chave (o sal da tabela) sorteada a cada
+geração, e a tabela sai ordenada por hash para a busca binária de lib/credenciais.c.
+As senhas em texto não vão para o firmware; guarde o arquivo de entrada fora do
+repositório.
+
+Uso: gerar_credenciais.py usuarios.txt [-o lib/credenciais_tabela.c] [--chave HEX32]
+"""
+
+import argparse
+import os
+import struct
+import sys
+
+TECLAS = set("0123456789*#")
+TAMANHO_SENHA = 4  # Igual a TAMANHO_SENHA em controle_de_acesso.c
+MASCARA = (1 << 64) - 1
+
+
+def _rotl(x, b):
+    return ((x << b) | (x >> (64 - b))) & MASCARA
+
+
+def _sipround(v):
+    v[0] = (v[0] + v[1]) & MASCARA
+    v[1] = _rotl(v[1], 13) ^ v[0]
+    v[0] = _rotl(v[0], 32)
+    v[2] = (v[2] + v[3]) & MASCARA
+    v[3] = _rotl(v[3], 16) ^ v[2]
+    v[0] = (v[0] + v[3]) & MASCARA
+    v[3] = _rotl(v[3], 21) ^ v[0]
+    v[2] = (v[2] + v[1]) & MASCARA
+    v[1] = _rotl(v[1], 17) ^ v[2]
+    v[2] = _rotl(v[2], 32)
+
+
+def siphash24(chave, dados):
+    """SipHash-2-4 de 64 bits, igual a credenciais_hash()."""
+    k0, k1 = struct.unpack("<QQ", chave)
+    v = [k0 ^ 0x736F6D6570736575, k1 ^ 0x646F72616E646F6D,
+         k0 ^ 0x6C7967656E657261, k1 ^ 0x7465646279746573]
+    inteiros = len(dados) & ~7
+    for i in range(0, inteiros, 8):
+        (bloco,) = struct.unpack_from("<Q", dados, i)
+        v[3] ^= bloco
+        _sipround(v)
+        _sipround(v)
+        v[0] ^= bloco
+    bloco = (len(dados) & 0xFF) << 56
+    for i, byte in enumerate(dados[inteiros:]):
+        bloco |= byte << (8 * i)
+    v[3] ^= bloco
+    _sipround(v)
+    _sipround(v)
+    v[0] ^= bloco
+    v[2] ^= 0xFF
+    for _ in range(4):
+        _sipround(v)
+    return v[0] ^ v[1] ^ v[2] ^ v[3]
+
+
+def ler_credenciais(caminho):
+    credenciais = []
+    with open(caminho, encoding="utf-8") as arquivo:
+        for numero, linha in enumerate(arquivo, 1):
+            linha = linha.strip()
+            if not linha or linha.startswith("#"):
+                continue
+            try:
+                usuario, senha = (campo.strip() for campo in linha.split(","))
+                usuario = int(usuario)
+            except ValueError:
+                sys.exit(f"{caminho}:{numero}: esperado <usuario>,<senha>")
+            if not 0 <= usuario <= 0xFFFFFFFF:
+                sys.exit(f"{caminho}:{numero}: usuário fora de 0..4294967295")
+            if len(senha) != TAMANHO_SENHA or not set(senha) <= TECLAS:
+                sys.exit(f"{caminho}:{numero}: a senha deve ter {TAMANHO_SENHA} teclas entre 0-9, * e #")
+            credenciais.append((numero, usuario, senha))
+    return credenciais
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("entrada", help="arquivo com <usuario>,<senha> por linha")
+    parser.add_argument("-o", "--saida", default="lib/credenciais_tabela.c")
+    parser.add_argument("--chave", help="chave de 16 bytes em hexadecimal (padrão: sorteada)")
+    args = parser.parse_args()
+
+    chave = bytes.fromhex(args.chave) if args.chave else os.urandom(16)
+    if len(chave) != 16:
+        sys.exit("a chave deve ter 16 bytes (32 dígitos hexadecimais)")
+
+    entradas = {}
+    usuarios = set()
+    for numero, usuario, senha in ler_credenciais(args.entrada):
+        if usuario in usuarios:
+            sys.exit(f"{args.entrada}:{numero}: usuário {usuario} repetido")
+        hash_senha = siphash24(chave, senha.encode("ascii"))
+        if hash_senha in entradas:
+            # Uma senha identifica um único usuário (ou, com chance desprezível, colidiu: gere outra chave)
+            sys.exit(f"{args.entrada}:{numero}: senha igual à do usuário {entradas[hash_senha]}")
+        entradas[hash_senha] = usuario
+        usuarios.add(usuario)
+
+    linhas = [
+        "// Gerado por ferramentas/gerar_credenciais.py; não edite.",
+        '#include "credenciais.h"',
+        "",
+    ]
+    if entradas:
+        linhas.append("static const credencial_t entradas[] = {")
+        linhas += [f"    {{0x{h:016x}ull, {u}u}}," for h, u in sorted(entradas.items())]
+        linhas += ["};", ""]
+    linhas += [
+        "const credenciais_tabela_t credenciais = {",
+        "    .chave = {" + ", ".join(f"0x{b:02x}" for b in chave) + "},",
+        f"    .total = {len(entradas)},",
+        "    .entradas = " + ("entradas" if entradas else "NULL") + ",",
+        "};",
+        "",
+    ]
+    with open(args.saida, "w", encoding="utf-8") as saida:
+        saida.write("\n".join(linhas))
+    print(f"{args.saida}: {len(entradas)} credenciais")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,283 @@
+#!/usr/bin/env python3
+"""Gera lib/imagens.h e lib/imagens_tabela.c com imagens comprimidas para o display.
+
+Entrada: arquivos PBM (P1 ou P4) ou PNG (8 bits por canal ou paleta/cinza de 1, 2, 4 e
+8 bits, sem entrelaçamento). No PBM, o pixel preto (1) acende o LED; no PNG acendem os
+pixels escuros e opacos. Com --inverter, o contrário. Cada arquivo vira uma constante
+ssd1306_image_t chamada imagem_<nome do arquivo>.
+
+Formato (o mesmo de ssd1306_draw_image em lib/ssd1306.c): os bytes do framebuffer da
+imagem, uma coluna de 8 pixels por byte (bit 0 no alto), página a página, comprimidos em
+RLE. Cada bloco começa com um byte de controle c:
+  c < 0x80: c + 1 bytes literais a seguir;
+  c >= 0x80: o byte seguinte repetido (c - 0x80) + 2 vezes.
+Os blocos podem atravessar o fim de uma página. O firmware desenha direto da flash, sem
+descomprimir para a RAM.
+
+Uso: gerar_imagens.py imagem.pbm [...] [-o lib] [--inverter]
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+import zlib
+
+LARGURA_MAX = 128  # WIDTH em lib/ssd1306.h
+ALTURA_MAX = 64    # HEIGHT em lib/ssd1306.h
+LITERAL_MAX = 128
+REPETICAO_MAX = 129
+
+
+def _tokens_pbm(dados):
+    """Campos do cabeçalho PBM, pulando comentários; retorna os campos e o resto."""
+    campos = []
+    i = 0
+    while len(campos) < 3:
+        while i < len(dados) and dados[i:i + 1].isspace():
+            i += 1
+        if dados[i:i + 1] == b"#":
+            while i < len(dados) and dados[i:i + 1] not in (b"\n", b"\r"):
+                i += 1
+            continue
+        inicio = i
+        while i < len(dados) and not dados[i:i + 1].isspace():
+            i += 1
+        campos.append(dados[inicio:i])
+    return campos, dados[i + 1:]
+
+
+def ler_pbm(caminho):
+    with open(caminho, "rb") as arquivo:
+        dados = arquivo.read()
+    (magico, largura, altura), resto = _tokens_pbm(dados)
+    largura, altura = int(largura), int(altura)
+    if magico == b"P1":
+        texto = re.sub(rb"#[^\n]*", b"", resto)
+        bits = [int(c) for c in re.findall(rb"[01]", texto)]
+    elif magico == b"P4":
+        por_linha = (largura + 7) // 8
+        bits = []
+        for y in range(altura):
+            linha = resto[y * por_linha:(y + 1) * por_linha]
+            bits += [(linha[x // 8] >> (7 - x % 8)) & 1 for x in range(largura)]
+    else:
+        sys.exit(f"{caminho}: PBM precisa ser P1 ou P4")
+    if len(bits) < largura * altura:
+        sys.exit(f"{caminho}: faltam pixels")
+    return largura, altura, [bits[y * largura:(y + 1) * largura] for y in range(altura)]
+
+
+def _paeth(a, b, c):
+    p = a + b - c
+    pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+    if pa <= pb and pa <= pc:
+        return a
+    return b if pb <= pc else c
+
+
+def ler_png(caminho):
+    with open(caminho, "rb") as arquivo:
+        dados = arquivo.read()
+    if dados[:8] != b"\x89PNG\r\n\x1a\n":
+        sys.exit(f"{caminho}: não é PNG")
+
+    idat = b""
+    paleta = []
+    transparencia = b""
+    i = 8
+    while i < len(dados):
+        (tamanho,) = struct.unpack_from(">I", dados, i)
+        tipo = dados[i + 4:i + 8]
+        corpo = dados[i + 8:i + 8 + tamanho]
+        i += 12 + tamanho
+        if tipo == b"IHDR":
+            largura, altura, profundidade, cor, _, _, entrelacado = struct.unpack(">IIBBBBB", corpo)
+        elif tipo == b"PLTE":
+            paleta = [tuple(corpo[j:j + 3]) for j in range(0, len(corpo), 3)]
+        elif tipo == b"tRNS":
+            transparencia = corpo
+        elif tipo == b"IDAT":
+            idat += corpo
+        elif tipo == b"IEND":
+            break
+
+    canais = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}.get(cor)
+    if canais is None or entrelacado or profundidade == 16 or (canais > 1 and profundidade != 8):
+        sys.exit(f"{caminho}: formato de PNG não suportado")
+
+    bits_pixel = canais * profundidade
+    por_linha = (largura * bits_pixel + 7) // 8
+    passo = max(1, bits_pixel // 8)
+    bruto = zlib.decompress(idat)
+    anterior = bytearray(por_linha)
+    linhas = []
+    for y in range(altura):
+        filtro = bruto[y * (por_linha + 1)]
+        linha = bytearray(bruto[y * (por_linha + 1) + 1:(y + 1) * (por_linha + 1)])
+        for x in range(por_linha):
+            a = linha[x - passo] if x >= passo else 0
+            b = anterior[x]
+            c = anterior[x - passo] if x >= passo else 0
+            if filtro == 1:
+                linha[x] = (linha[x] + a) & 0xFF
+            elif filtro == 2:
+                linha[x] = (linha[x] + b) & 0xFF
+            elif filtro == 3:
+                linha[x] = (linha[x] + (a + b) // 2) & 0xFF
+            elif filtro == 4:
+                linha[x] = (linha[x] + _paeth(a, b, c)) & 0xFF
+        linhas.append(linha)
+        anterior = linha
+
+    maximo = (1 << profundidade) - 1
+    pixels = []
+    for linha in linhas:
+        saida = []
+        for x in range(largura):
+            if profundidade < 8:
+                valor = (linha[x * profundidade // 8] >> (8 - profundidade - x * profundidade % 8)) & maximo
+                amostras = [valor]
+            else:
+                amostras = list(linha[x * canais:(x + 1) * canais])
+            alfa = 255
+            if cor == 3:
+                alfa = transparencia[amostras[0]] if amostras[0] < len(transparencia) else 255
+                r, g, b = paleta[amostras[0]]
+            elif cor in (0, 4):
+                r = g = b = amostras[0] * 255 // maximo
+                if cor == 4:
+                    alfa = amostras[1]
+            else:
+                r, g, b = amostras[:3]
+                if cor == 6:
+                    alfa = amostras[3]
+            luminancia = (299 * r + 587 * g + 114 * b) // 1000
+            saida.append(1 if alfa >= 128 and luminancia < 128 else 0)
+        pixels.append(saida)
+    return largura, altura, pixels
+
+
+def paginas(largura, altura, pixels):
+    """Bytes no formato do framebuffer: colunas de 8 pixels, página a página."""
+    saida = bytearray()
+    for pagina in range((altura + 7) // 8):
+        for x in range(largura):
+            byte = 0
+            for bit in range(8):
+                y = pagina * 8 + bit
+                if y < altura and pixels[y][x]:
+                    byte |= 1 << bit
+            saida.append(byte)
+    return bytes(saida)
+
+
+def comprimir(dados):
+    saida = bytearray()
+    literal = bytearray()
+
+    def fechar_literal():
+        for inicio in range(0, len(literal), LITERAL_MAX):
+            bloco = literal[inicio:inicio + LITERAL_MAX]
+            saida.append(len(bloco) - 1)
+            saida.extend(bloco)
+        literal.clear()
+
+    i = 0
+    while i < len(dados):
+        repeticao = 1
+        while i + repeticao < len(dados) and dados[i + repeticao] == dados[i] and repeticao < REPETICAO_MAX:
+            repeticao += 1
+        # Duas repetições só compensam fora de um literal, que teria de ser fechado
+        if repeticao >= 3 or (repeticao == 2 and not literal):
+            fechar_literal()
+            saida += bytes([0x80 + repeticao - 2, dados[i]])
+            i += repeticao
+        else:
+            literal.append(dados[i])
+            i += 1
+    fechar_literal()
+    return bytes(saida)
+
+
+def descomprimir(dados):
+    """Igual a ssd1306_draw_image, para conferir o que foi gerado."""
+    saida = bytearray()
+    i = 0
+    while i < len(dados):
+        controle = dados[i]
+        if controle >= 0x80:
+            saida += bytes([dados[i + 1]]) * (controle - 0x80 + 2)
+            i += 2
+        else:
+            saida += dados[i + 1:i + 2 + controle]
+            i += 2 + controle
+    return bytes(saida)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("entradas", nargs="+", help="arquivos .pbm ou .png")
+    parser.add_argument("-o", "--saida", default="lib", help="diretório de imagens.h e imagens_tabela.c")
+    parser.add_argument("--inverter", action="store_true", help="acende os pixels claros")
+    args = parser.parse_args()
+
+    imagens = []
+    for caminho in args.entradas:
+        nome, extensao = os.path.splitext(os.path.basename(caminho))
+        nome = re.sub(r"\W", "_", nome.lower())
+        if extensao.lower() == ".pbm":
+            largura, altura, pixels = ler_pbm(caminho)
+        elif extensao.lower() == ".png":
+            largura, altura, pixels = ler_png(caminho)
+        else:
+            sys.exit(f"{caminho}: use .pbm ou .png")
+        if not 0 < largura <= LARGURA_MAX or not 0 < altura <= ALTURA_MAX:
+            sys.exit(f"{caminho}: maior que {LARGURA_MAX}x{ALTURA_MAX}")
+        if args.inverter:
+            pixels = [[1 - p for p in linha] for linha in pixels]
+
+        bruto = paginas(largura, altura, pixels)
+        comprimido = comprimir(bruto)
+        assert descomprimir(comprimido) == bruto
+        imagens.append((nome, os.path.basename(caminho), largura, altura, len(bruto), comprimido))
+
+    cabecalho = [
+        "// Gerado por ferramentas/gerar_imagens.py; não edite.",
+        "#ifndef IMAGENS_H",
+        "#define IMAGENS_H",
+        "",
+        '#include "ssd1306.h"',
+        "",
+    ]
+    cabecalho += [f"extern const ssd1306_image_t imagem_{nome};" for nome, *_ in imagens]
+    cabecalho += ["", "#endif // IMAGENS_H", ""]
+
+    tabela = [
+        "// Gerado por ferramentas/gerar_imagens.py; não edite.",
+        '#include "imagens.h"',
+        "",
+    ]
+    for nome, arquivo, largura, altura, tamanho_bruto, comprimido in imagens:
+        tabela.append(f"// {arquivo}: {largura}x{altura}, {len(comprimido)} bytes ({tamanho_bruto} sem compressão)")
+        tabela.append(f"static const uint8_t dados_{nome}[] = {{")
+        for inicio in range(0, len(comprimido), 16):
+            tabela.append("    " + " ".join(f"0x{b:02x}," for b in comprimido[inicio:inicio + 16]))
+        tabela += [
+            "};",
+            "",
+            f"const ssd1306_image_t imagem_{nome} = {{{largura}, {altura}, sizeof(dados_{nome}), dados_{nome}}};",
+            "",
+        ]
+
+    with open(os.path.join(args.saida, "imagens.h"), "w", encoding="utf-8") as saida:
+        saida.write("\n".join(cabecalho))
+    with open(os.path.join(args.saida, "imagens_tabela.c"), "w", encoding="utf-8") as saida:
+        saida.write("\n".join(tabela))
+    for nome, _, largura, altura, tamanho_bruto, comprimido in imagens:
+        print(f"imagem_{nome}: {largura}x{altura}, {tamanho_bruto} -> {len(comprimido)} bytes")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,188 @@
+#include "animacao.h"
+#include "hardware/sync.h"
+
+static repeating_timer_t temporizador;
+static alarm_pool_t *pool_temporizador;
+static volatile bool rodando = false; // O temporizador está agendado
+static uint32_t periodo_us;
+static uint64_t proximo_quadro_us; // Quando o próximo tick deveria acontecer
+
+// Pedidos feitos pelo loop principal e atendidos no próximo tick do temporizador
+static const animacao_t *volatile pedido = NULL;
+static volatile bool pedido_parar = false;
+
+// Animação em reprodução (acessada só pelo callback do temporizador)
+static const animacao_t *atual = NULL;
+static uint8_t indice = 0;          // Quadro-chave atual
+static uint64_t inicio_quadro_us;   // Momento em que o quadro-chave atual começou
+static volatile bool ativa = false;
+
+volatile animacao_estatisticas_t animacao_estatisticas;
+
+// Mistura dois canais em ponto fixo (t em Q8: 0 = a, 256 = b)
+static inline uint8_t animacao_misturar(uint8_t a, uint8_t b, uint16_t t)
+{
+  return (uint8_t)(a + ((((int32_t)b - a) * t) >> 8));
+}
+
+// Desenha no framebuffer da matriz o quadro 'a' misturado com 'b' na proporção t
+static void animacao_renderizar(const animacao_quadro_t *a, const animacao_quadro_t *b, uint16_t t)
+{
+  for (uint8_t y = 0; y < MATRIZ_ALTURA; y++)
+  {
+    for (uint8_t x = 0; x < MATRIZ_LARGURA; x++)
+    {
+      uint8_t bit = 1u << (MATRIZ_LARGURA - 1 - x);
+      bool aceso_a = a->linhas[y] & bit;
+      bool aceso_b = b->linhas[y] & bit;
+      uint8_t r = animacao_misturar(aceso_a ? a->r : 0, aceso_b ? b->r : 0, t);
+      uint8_t g = animacao_misturar(aceso_a ? a->g : 0, aceso_b ? b->g : 0, t);
+      uint8_t bl = animacao_misturar(aceso_a ? a->b : 0, aceso_b ? b->b : 0, t);
+      matriz_pixel(x, y, ((uint32_t)r << 16) | ((uint32_t)g << 8) | bl);
+    }
+  }
+}
+
+// Calcula e envia o quadro correspondente ao instante 'agora'
+static void animacao_avancar(uint64_t agora)
+{
+  // Pula os quadros-chave cujo tempo já passou
+  while (atual->quadros[indice].duracao_ms &&
+         agora - inicio_quadro_us >= (uint64_t)atual->quadros[indice].duracao_ms * 1000)
+  {
+    if (indice + 1 < atual->total)
+    {
+      inicio_quadro_us += (uint64_t)atual->quadros[indice].duracao_ms * 1000;
+      indice++;
+    }
+    else if (atual->repetir)
+    {
+      inicio_quadro_us += (uint64_t)atual->quadros[indice].duracao_ms * 1000;
+      indice = 0;
+    }
+    else
+    {
+      break; // Último quadro fica na tela
+    }
+  }
+
+  const animacao_quadro_t *quadro = &atual->quadros[indice];
+  const animacao_quadro_t *seguinte = quadro;
+  uint16_t t = 0;
+  if (quadro->interpolar && quadro->duracao_ms)
+  {
+    if (indice + 1 < atual->total)
+      seguinte = &atual->quadros[indice + 1];
+    else if (atual->repetir)
+      seguinte = &atual->quadros[0];
+
+    uint64_t decorrido = agora - inicio_quadro_us;
+    uint64_t duracao = (uint64_t)quadro->duracao_ms * 1000;
+    t = decorrido >= duracao ? 256 : (uint16_t)((decorrido << 8) / duracao);
+  }
+
+  animacao_renderizar(quadro, seguinte, t);
+  if (!matriz_atualizar())
+    animacao_estatisticas.descartados++;
+
+  // Quadro parado para sempre (duração 0 ou o último sem repetição, já no fim): a animação
+  // termina com ele na matriz. Se o envio ficou pendente, matriz_processar o completa.
+  if (!quadro->duracao_ms ||
+      (!atual->repetir && indice + 1 == atual->total &&
+       agora - inicio_quadro_us >= (uint64_t)quadro->duracao_ms * 1000))
+  {
+    atual = NULL;
+    ativa = pedido != NULL;
+  }
+}
+
+// Tick do temporizador: atende pedidos, detecta atrasos e avança a animação
+static bool animacao_tick(repeating_timer_t *rt)
+{
+  (void)rt;
+  uint64_t agora = time_us_64();
+
+  if (agora > proximo_quadro_us + periodo_us)
+    animacao_estatisticas.atrasados += (agora - proximo_quadro_us) / periodo_us;
+  proximo_quadro_us += periodo_us;
+  if (proximo_quadro_us < agora)
+    proximo_quadro_us = agora + periodo_us; // Realinha depois de um atraso longo
+
+  if (pedido_parar)
+  {
+    pedido_parar = false;
+    atual = NULL;
+    ativa = false;
+    matriz_preencher(MATRIZ_PRETO);
+    matriz_atualizar();
+  }
+
+  const animacao_t *nova = pedido;
+  if (nova)
+  {
+    pedido = NULL;
+    atual = nova;
+    indice = 0;
+    inicio_quadro_us = agora;
+    ativa = true;
+  }
+
+  if (atual)
+    animacao_avancar(agora);
+  else
+    matriz_processar(); // Só reenvia o que ficou pendente
+
+  // Sem animação, pedido ou envio pendente, o temporizador para e o núcleo pode dormir;
+  // animacao_tocar e animacao_parar o religam
+  if (!atual && !pedido && !pedido_parar && !matriz_pendente())
+  {
+    rodando = false;
+    return false;
+  }
+  return true;
+}
+
+// Agenda o temporizador se ele estiver parado
+static void animacao_religar(void)
+{
+  uint32_t interrupcoes = save_and_disable_interrupts();
+  if (!rodando)
+  {
+    proximo_quadro_us = time_us_64() + periodo_us;
+    // Período negativo: intervalo medido entre inícios, sem acumular o tempo do callback
+    rodando = alarm_pool_add_repeating_timer_us(pool_temporizador, -(int64_t)periodo_us, animacao_tick, NULL,
+                                                &temporizador);
+  }
+  restore_interrupts(interrupcoes);
+}
+
+// Prepara as animações a 'fps' quadros por segundo. 'pool' define em que núcleo o
+// temporizador roda (NULL = pool padrão); ele só fica agendado enquanto há o que animar.
+void animacao_init(uint32_t fps, alarm_pool_t *pool)
+{
+  periodo_us = 1000000 / fps;
+  pool_temporizador = pool ? pool : alarm_pool_get_default();
+}
+
+// Começa a tocar uma animação a partir do primeiro quadro (no próximo tick)
+void animacao_tocar(const animacao_t *animacao)
+{
+  pedido_parar = false;
+  pedido = animacao;
+  ativa = true;
+  animacao_religar();
+}
+
+// Interrompe a animação e apaga a matriz
+void animacao_parar(void)
+{
+  pedido = NULL;
+  pedido_parar = true;
+  animacao_religar();
+}
+
+// Verifica se há uma animação em reprodução (falso depois que o último quadro fica parado)
+bool animacao_ativa(void)
+{
+  return ativa;
+}
@@ -0,0 +1,42 @@
+#ifndef ANIMACAO_H
+#define ANIMACAO_H
+
+#include "pico/stdlib.h"
+#include "matriz_led.h"
+
+#define ANIMACAO_FPS_PADRAO 30
+
+// Quadro-chave: ícone 5x5 (bit 4 de cada linha = coluna 0) numa cor, mantido por 'duracao_ms'.
+// Com 'interpolar', a cor de cada LED faz a transição gradual até o quadro seguinte.
+// Duração 0 mantém o quadro indefinidamente.
+typedef struct
+{
+  uint8_t linhas[MATRIZ_ALTURA];
+  uint8_t r, g, b;
+  uint8_t interpolar;
+  uint16_t duracao_ms;
+} animacao_quadro_t;
+
+// Sequência de quadros-chave guardada como const (fica na flash)
+typedef struct
+{
+  const animacao_quadro_t *quadros;
+  uint8_t total;
+  bool repetir; // Volta ao primeiro quadro; sem repetição o último quadro fica na tela e a animação termina
+} animacao_t;
+
+// Quadros perdidos pelo temporizador; lidos pelas métricas (veja lib/metricas.h)
+typedef struct
+{
+  uint32_t atrasados;   // Ticks que chegaram com mais de um período de atraso
+  uint32_t descartados; // Quadros calculados que não foram enviados porque a matriz estava ocupada
+} animacao_estatisticas_t;
+
+extern volatile animacao_estatisticas_t animacao_estatisticas;
+
+void animacao_init(uint32_t fps, alarm_pool_t *pool);
+void animacao_tocar(const animacao_t *animacao);
+void animacao_parar(void);
+bool animacao_ativa(void);
+
+#endif // ANIMACAO_H
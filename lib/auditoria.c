@@ -0,0 +1,291 @@
+#include "auditoria.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#define POR_SETOR (AUDITORIA_SETOR / sizeof(auditoria_registro_t))
+
+auditoria_estatisticas_t auditoria_estatisticas;
+
+static const auditoria_meio_t *meio = NULL;
+static uint32_t total_posicoes; // Registros que cabem na região
+static uint32_t sequencia;      // Sequência do próximo registro
+
+// Página onde entra o próximo registro. Os registros já gravados nela são regravados
+// iguais junto com os novos: na flash, gravar só leva bits de 1 para 0.
+static uint8_t pagina[AUDITORIA_PAGINA];
+static uint32_t pagina_base; // Posição do primeiro registro da página
+static uint32_t ocupados;    // Registros na página (gravados ou não)
+static uint32_t pendentes;   // Registros da página ainda não gravados
+static uint32_t primeiro_pendente_ms;
+
+static bool setor_pronto;     // O setor da página atual já pode receber gravações
+static bool proximo_apagado;  // O setor seguinte foi apagado com antecedência
+
+// CRC-16/CCITT (polinômio 0x1021, valor inicial 0xFFFF)
+static uint16_t crc16(const uint8_t *dados, size_t tamanho)
+{
+  uint16_t crc = 0xFFFF;
+  for (size_t i = 0; i < tamanho; i++)
+  {
+    crc ^= (uint16_t)dados[i] << 8;
+    for (int bit = 0; bit < 8; bit++)
+      crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+  }
+  return crc;
+}
+
+static bool registro_valido(const auditoria_registro_t *registro)
+{
+  return registro->sequencia != UINT32_MAX &&
+         registro->crc == crc16((const uint8_t *)registro, offsetof(auditoria_registro_t, crc));
+}
+
+static bool em_branco(const void *dados, size_t tamanho)
+{
+  const uint8_t *bytes = dados;
+  for (size_t i = 0; i < tamanho; i++)
+  {
+    if (bytes[i] != 0xFF)
+      return false;
+  }
+  return true;
+}
+
+// Lê um registro; os da página atual vêm da RAM, que pode ter registros ainda não gravados
+static void ler_posicao(uint32_t posicao, auditoria_registro_t *registro)
+{
+  if (posicao - pagina_base < AUDITORIA_POR_PAGINA)
+    memcpy(registro, &pagina[(posicao - pagina_base) * sizeof(*registro)], sizeof(*registro));
+  else
+    meio->ler(meio->contexto, posicao * sizeof(*registro), registro, sizeof(*registro));
+}
+
+static bool setor_em_branco(uint32_t setor)
+{
+  uint8_t bloco[AUDITORIA_PAGINA];
+  for (uint32_t deslocamento = 0; deslocamento < AUDITORIA_SETOR; deslocamento += sizeof(bloco))
+  {
+    meio->ler(meio->contexto, setor * AUDITORIA_SETOR + deslocamento, bloco, sizeof(bloco));
+    if (!em_branco(bloco, sizeof(bloco)))
+      return false;
+  }
+  return true;
+}
+
+static uint32_t setor_seguinte(uint32_t setor)
+{
+  return (setor + 1) % (meio->tamanho / AUDITORIA_SETOR);
+}
+
+static bool apagar_setor(uint32_t setor)
+{
+  if (!meio->apagar(meio->contexto, setor * AUDITORIA_SETOR))
+  {
+    auditoria_estatisticas.falhas++;
+    return false;
+  }
+  auditoria_estatisticas.setores_apagados++;
+  return true;
+}
+
+// Passa para a página seguinte; ao entrar num setor, aproveita o apagamento antecipado
+static void avancar_pagina(void)
+{
+  pagina_base = (pagina_base + AUDITORIA_POR_PAGINA) % total_posicoes;
+  ocupados = 0;
+  memset(pagina, 0xFF, sizeof(pagina));
+  if (pagina_base % POR_SETOR == 0)
+  {
+    setor_pronto = proximo_apagado;
+    proximo_apagado = false;
+  }
+}
+
+// Reencontra o fim do registro. O setor mais novo é o de maior sequência no início;
+// dentro dele, o próximo registro entra depois do último válido. Se o resto da página
+// não estiver em branco (gravação interrompida), o registro continua na página seguinte.
+bool auditoria_init(const auditoria_meio_t *novo_meio)
+{
+  if (novo_meio->tamanho % AUDITORIA_SETOR != 0 || novo_meio->tamanho < 2 * AUDITORIA_SETOR)
+    return false;
+
+  meio = novo_meio;
+  total_posicoes = meio->tamanho / sizeof(auditoria_registro_t);
+  pagina_base = 0;
+  ocupados = 0;
+  pendentes = 0;
+  memset(pagina, 0xFF, sizeof(pagina));
+
+  uint32_t setores = meio->tamanho / AUDITORIA_SETOR;
+  uint32_t setor_novo = UINT32_MAX;
+  uint32_t maior = 0;
+  auditoria_registro_t registro;
+  for (uint32_t setor = 0; setor < setores; setor++)
+  {
+    for (uint32_t i = 0; i < AUDITORIA_POR_PAGINA; i++)
+    {
+      meio->ler(meio->contexto, (setor * POR_SETOR + i) * sizeof(registro), &registro, sizeof(registro));
+      if (registro_valido(&registro))
+      {
+        if (setor_novo == UINT32_MAX || registro.sequencia > maior)
+        {
+          setor_novo = setor;
+          maior = registro.sequencia;
+        }
+        break;
+      }
+    }
+  }
+
+  if (setor_novo == UINT32_MAX)
+  {
+    // Registro vazio
+    sequencia = 1;
+    setor_pronto = setor_em_branco(0);
+    proximo_apagado = setor_em_branco(1);
+    return true;
+  }
+
+  uint32_t ultima = 0;
+  for (uint32_t i = 0; i < POR_SETOR; i++)
+  {
+    meio->ler(meio->contexto, (setor_novo * POR_SETOR + i) * sizeof(registro), &registro, sizeof(registro));
+    if (registro_valido(&registro) && registro.sequencia >= maior)
+    {
+      maior = registro.sequencia;
+      ultima = i;
+    }
+  }
+  sequencia = maior + 1;
+
+  uint32_t proxima = (setor_novo * POR_SETOR + ultima + 1) % total_posicoes;
+  pagina_base = proxima - proxima % AUDITORIA_POR_PAGINA;
+  ocupados = proxima - pagina_base;
+  proximo_apagado = false;
+  if (proxima % POR_SETOR == 0)
+  {
+    // O setor mais novo está cheio: o próximo ainda guarda registros antigos
+    setor_pronto = setor_em_branco(pagina_base / POR_SETOR);
+  }
+  else
+  {
+    setor_pronto = true;
+    meio->ler(meio->contexto, pagina_base * sizeof(registro), pagina, sizeof(pagina));
+    if (!em_branco(&pagina[ocupados * sizeof(registro)], sizeof(pagina) - ocupados * sizeof(registro)))
+    {
+      ocupados = AUDITORIA_POR_PAGINA; // Descarta o resto da página
+      avancar_pagina();
+      if (!setor_pronto)
+        setor_pronto = setor_em_branco(pagina_base / POR_SETOR);
+    }
+  }
+  proximo_apagado = setor_em_branco(setor_seguinte(pagina_base / POR_SETOR));
+  return true;
+}
+
+// Acrescenta um registro à página em RAM; a gravação fica para auditoria_atender
+void auditoria_registrar(auditoria_tipo_t tipo, uint32_t usuario, uint8_t dado, uint32_t agora_ms)
+{
+  if (!meio)
+    return;
+
+  if (ocupados == AUDITORIA_POR_PAGINA)
+    auditoria_gravar(); // Página cheia ainda não gravada
+
+  auditoria_registro_t registro = {
+      .sequencia = sequencia++,
+      .instante_ms = agora_ms,
+      .usuario = usuario,
+      .tipo = (uint8_t)tipo,
+      .dado = dado,
+  };
+  registro.crc = crc16((const uint8_t *)&registro, offsetof(auditoria_registro_t, crc));
+  memcpy(&pagina[ocupados * sizeof(registro)], &registro, sizeof(registro));
+  ocupados++;
+  if (pendentes++ == 0)
+    primeiro_pendente_ms = agora_ms;
+  auditoria_estatisticas.registros++;
+}
+
+// Grava a página atual. Se a gravação falhar os registros pendentes são perdidos,
+// para que um meio com defeito não trave quem registra.
+void auditoria_gravar(void)
+{
+  if (!meio || pendentes == 0)
+    return;
+
+  if (!setor_pronto)
+    setor_pronto = apagar_setor(pagina_base / POR_SETOR);
+
+  if (setor_pronto && meio->programar(meio->contexto, pagina_base * sizeof(auditoria_registro_t), pagina))
+    auditoria_estatisticas.paginas_gravadas++;
+  else
+    auditoria_estatisticas.falhas++;
+
+  pendentes = 0;
+  if (ocupados == AUDITORIA_POR_PAGINA)
+    avancar_pagina();
+}
+
+// Chamada a cada iteração do loop principal. Grava em lotes de uma página (ou quando o
+// registro mais antigo atinge o atraso máximo) e, com o sistema ocioso, apaga o setor
+// seguinte com antecedência, para que o apagamento, bem mais lento que a gravação,
+// não aconteça enquanto alguém usa o teclado.
+void auditoria_atender(uint32_t agora_ms, bool ocioso)
+{
+  if (!meio)
+    return;
+
+  if (pendentes > 0 && (ocupados == AUDITORIA_POR_PAGINA || agora_ms - primeiro_pendente_ms >= AUDITORIA_ATRASO_MAX_MS))
+    auditoria_gravar();
+
+  if (ocioso && !proximo_apagado)
+    proximo_apagado = apagar_setor(setor_seguinte(pagina_base / POR_SETOR));
+}
+
+// Começa a percorrer os registros a partir do mais novo, inclusive os ainda não gravados
+void auditoria_iterar(auditoria_iterador_t *iterador)
+{
+  iterador->posicao = meio ? (pagina_base + ocupados) % total_posicoes : 0;
+  iterador->restantes = meio ? total_posicoes : 0;
+  iterador->sequencia = sequencia;
+}
+
+// Entrega o registro anterior; posições em branco ou corrompidas são puladas
+bool auditoria_anterior(auditoria_iterador_t *iterador, auditoria_registro_t *registro)
+{
+  while (iterador->restantes > 0)
+  {
+    iterador->restantes--;
+    iterador->posicao = (iterador->posicao + total_posicoes - 1) % total_posicoes;
+    ler_posicao(iterador->posicao, registro);
+    if (registro_valido(registro) && registro->sequencia < iterador->sequencia)
+    {
+      iterador->sequencia = registro->sequencia;
+      return true;
+    }
+  }
+  return false;
+}
+
+// Imprime até 'maximo' registros, do mais novo para o mais antigo, no formato de linhas:
+//   auditoria <registros gravados desde que o sistema foi ligado>
+//   registro <sequência> <instante_ms> <tipo> <usuário> <dado>
+//   fim
+void auditoria_imprimir(uint32_t maximo)
+{
+  static const char *const nomes[] = {"?", "inicio", "liberado", "negado", "bloqueio", "modo_usb"};
+
+  printf("auditoria %lu\n", (unsigned long)auditoria_estatisticas.registros);
+  auditoria_iterador_t iterador;
+  auditoria_registro_t registro;
+  auditoria_iterar(&iterador);
+  for (uint32_t i = 0; i < maximo && auditoria_anterior(&iterador, &registro); i++)
+  {
+    const char *nome = registro.tipo < sizeof(nomes) / sizeof(nomes[0]) ? nomes[registro.tipo] : nomes[0];
+    printf("registro %lu %lu %s %lu %u\n", (unsigned long)registro.sequencia, (unsigned long)registro.instante_ms,
+           nome, (unsigned long)registro.usuario, registro.dado);
+  }
+  printf("fim\n");
+}
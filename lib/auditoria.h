@@ -0,0 +1,81 @@
+#ifndef AUDITORIA_H
+#define AUDITORIA_H
+
+#include "pico/stdlib.h"
+
+// Registro de auditoria em flash, só de acréscimo. Os registros ficam numa página em RAM
+// e são gravados de uma vez quando a página enche ou quando o mais antigo espera mais que
+// AUDITORIA_ATRASO_MAX_MS. A região é um anel de setores: ao entrar num setor ele é
+// apagado, descartando os registros mais antigos, então todos os setores se desgastam
+// por igual. Na inicialização o fim do registro é reencontrado pelos números de
+// sequência; registros interrompidos por falta de energia falham no CRC e são ignorados.
+
+#define AUDITORIA_PAGINA 256  // Menor unidade gravada na flash
+#define AUDITORIA_SETOR 4096  // Menor unidade apagada na flash
+#define AUDITORIA_ATRASO_MAX_MS 2000
+#define AUDITORIA_FLASH_SETORES 8 // Região no fim da flash: 32 KB, 2048 registros
+
+// Tipos de registro
+typedef enum
+{
+  AUDITORIA_INICIO = 1, // Sistema ligado
+  AUDITORIA_LIBERADO,   // usuario: dono da senha
+  AUDITORIA_NEGADO,     // dado: tentativas falhas seguidas
+  AUDITORIA_BLOQUEIO,   // dado: tentativas falhas seguidas
+  AUDITORIA_MODO_USB
+} auditoria_tipo_t;
+
+// Registro gravado na flash (16 bytes, 16 por página)
+typedef struct
+{
+  uint32_t sequencia;   // Cresce de 1 em 1 desde o primeiro registro
+  uint32_t instante_ms; // Desde que o sistema foi ligado
+  uint32_t usuario;
+  uint8_t tipo;
+  uint8_t dado;
+  uint16_t crc; // CRC-16/CCITT dos 14 bytes anteriores
+} auditoria_registro_t;
+
+#define AUDITORIA_POR_PAGINA (AUDITORIA_PAGINA / sizeof(auditoria_registro_t))
+
+// Meio de armazenamento: flash na placa (auditoria_flash.c), arquivo na simulação.
+// Deslocamentos relativos ao início da região; apagar recebe um setor, programar uma página.
+typedef struct
+{
+  uint32_t tamanho; // Múltiplo de AUDITORIA_SETOR, com pelo menos 2 setores
+  void (*ler)(void *contexto, uint32_t deslocamento, void *destino, size_t tamanho);
+  bool (*apagar)(void *contexto, uint32_t deslocamento);
+  bool (*programar)(void *contexto, uint32_t deslocamento, const uint8_t *pagina);
+  void *contexto;
+} auditoria_meio_t;
+
+// Percorre os registros do mais novo para o mais antigo
+typedef struct
+{
+  uint32_t posicao;   // Próxima posição a ler (já decrementada)
+  uint32_t restantes; // Posições ainda não visitadas
+  uint32_t sequencia; // Sequência do último registro entregue
+} auditoria_iterador_t;
+
+// Contadores de uso da flash, para as métricas
+typedef struct
+{
+  uint32_t registros;
+  uint32_t paginas_gravadas;
+  uint32_t setores_apagados;
+  uint32_t falhas; // Gravações ou apagamentos que o meio recusou
+} auditoria_estatisticas_t;
+
+extern auditoria_estatisticas_t auditoria_estatisticas;
+
+void auditoria_meio_flash(auditoria_meio_t *meio);
+
+bool auditoria_init(const auditoria_meio_t *meio);
+void auditoria_registrar(auditoria_tipo_t tipo, uint32_t usuario, uint8_t dado, uint32_t agora_ms);
+void auditoria_atender(uint32_t agora_ms, bool ocioso);
+void auditoria_gravar(void);
+void auditoria_iterar(auditoria_iterador_t *iterador);
+bool auditoria_anterior(auditoria_iterador_t *iterador, auditoria_registro_t *registro);
+void auditoria_imprimir(uint32_t maximo);
+
+#endif // AUDITORIA_H
@@ -0,0 +1,61 @@
+#include "auditoria.h"
+#include <string.h>
+#include "hardware/flash.h"
+#include "pico/flash.h"
+
+// Meio do registro de auditoria na flash da placa: os últimos AUDITORIA_FLASH_SETORES setores,
+// longe do programa, que fica no início da flash.
+
+#define REGIAO_INICIO (PICO_FLASH_SIZE_BYTES - AUDITORIA_FLASH_SETORES * FLASH_SECTOR_SIZE)
+#define ESPERA_MAX_MS 100 // Tempo para o núcleo 1 parar antes de desistir da operação
+
+typedef struct
+{
+  uint32_t endereco; // Relativo ao início da flash
+  const uint8_t *dados;
+} operacao_flash_t;
+
+// A leitura é direta pelo XIP
+static void ler(void *contexto, uint32_t deslocamento, void *destino, size_t tamanho)
+{
+  (void)contexto;
+  memcpy(destino, (const void *)(XIP_BASE + REGIAO_INICIO + deslocamento), tamanho);
+}
+
+static void apagar_setor(void *parametro)
+{
+  const operacao_flash_t *operacao = parametro;
+  flash_range_erase(operacao->endereco, FLASH_SECTOR_SIZE);
+}
+
+static void programar_pagina(void *parametro)
+{
+  const operacao_flash_t *operacao = parametro;
+  flash_range_program(operacao->endereco, operacao->dados, FLASH_PAGE_SIZE);
+}
+
+// Durante apagamentos e gravações o XIP fica desligado: flash_safe_execute pausa o núcleo 1
+// (que precisa ter chamado flash_safe_execute_core_init) e desliga as interrupções deste
+static bool apagar(void *contexto, uint32_t deslocamento)
+{
+  (void)contexto;
+  operacao_flash_t operacao = {REGIAO_INICIO + deslocamento, NULL};
+  return flash_safe_execute(apagar_setor, &operacao, ESPERA_MAX_MS) == PICO_OK;
+}
+
+static bool programar(void *contexto, uint32_t deslocamento, const uint8_t *pagina)
+{
+  (void)contexto;
+  operacao_flash_t operacao = {REGIAO_INICIO + deslocamento, pagina}; // 'pagina' está na RAM
+  return flash_safe_execute(programar_pagina, &operacao, ESPERA_MAX_MS) == PICO_OK;
+}
+
+// Preenche o meio que usa a flash da placa
+void auditoria_meio_flash(auditoria_meio_t *meio)
+{
+  meio->tamanho = AUDITORIA_FLASH_SETORES * FLASH_SECTOR_SIZE;
+  meio->ler = ler;
+  meio->apagar = apagar;
+  meio->programar = programar;
+  meio->contexto = NULL;
+}
@@ -0,0 +1,133 @@
+#include "botoes.h"
+#include "hardware/gpio.h"
+#include "hardware/sync.h"
+
+// Estado de debounce de cada botão (atualizado apenas na interrupção)
+typedef struct
+{
+  uint pino;
+  bool pressionado;        // Último estado aceito
+  uint32_t ultima_borda_us; // Momento da última borda aceita
+  alarm_id_t releitura;    // Alarme que confere o nível ao fim do debounce (0 = nenhum)
+} botao_estado_t;
+
+static botao_estado_t botoes[BOTOES_MAX];
+static size_t total_botoes = 0;
+static uint32_t tempo_debounce_us;
+
+// Fila SPSC sem trava: a interrupção escreve em 'fim', o loop principal lê em 'inicio'
+static botao_evento_t fila[BOTOES_FILA_TAMANHO];
+static volatile uint32_t fila_inicio = 0, fila_fim = 0;
+volatile uint32_t botoes_eventos_perdidos = 0;
+
+// Procura o estado do botão ligado ao pino
+static botao_estado_t *botoes_buscar(uint pino)
+{
+  for (size_t i = 0; i < total_botoes; i++)
+  {
+    if (botoes[i].pino == pino)
+      return &botoes[i];
+  }
+  return NULL;
+}
+
+// Acrescenta um evento à fila (chamado só em contexto de interrupção)
+static void botoes_publicar(botao_estado_t *botao, uint32_t agora)
+{
+  uint32_t fim = fila_fim;
+  if (fim - fila_inicio >= BOTOES_FILA_TAMANHO)
+  {
+    botoes_eventos_perdidos++;
+    return;
+  }
+  botao_evento_t *evento = &fila[fim % BOTOES_FILA_TAMANHO];
+  evento->pino = botao->pino;
+  evento->tipo = botao->pressionado ? BOTAO_PRESSIONADO : BOTAO_SOLTO;
+  evento->instante_us = agora;
+  __dmb(); // O evento precisa estar completo antes de ficar visível
+  fila_fim = fim + 1;
+}
+
+// Confere o nível do pino e gera um evento se ele mudou desde o último aceito
+static void botoes_conferir(botao_estado_t *botao, uint32_t agora)
+{
+  bool pressionado = !gpio_get(botao->pino); // Pull-up: nível baixo = pressionado
+  if (pressionado == botao->pressionado)
+    return;
+  botao->pressionado = pressionado;
+  botao->ultima_borda_us = agora;
+  botoes_publicar(botao, agora);
+}
+
+// Fim da janela de debounce: o nível pode ter mudado sem uma nova borda aceita
+static int64_t botoes_releitura(alarm_id_t id, void *user_data)
+{
+  (void)id;
+  botao_estado_t *botao = user_data;
+  botao->releitura = 0;
+  botoes_conferir(botao, time_us_32());
+  return 0;
+}
+
+// Interrupção de borda de qualquer um dos botões
+static void botoes_irq(uint gpio, uint32_t events)
+{
+  (void)events;
+  uint32_t agora = time_us_32();
+  botao_estado_t *botao = botoes_buscar(gpio);
+  if (!botao)
+    return;
+
+  uint32_t decorrido = agora - botao->ultima_borda_us;
+  if (decorrido < tempo_debounce_us)
+  {
+    // Ainda quicando: confere de novo quando a janela terminar
+    if (!botao->releitura)
+    {
+      alarm_id_t id = add_alarm_in_us(tempo_debounce_us - decorrido, botoes_releitura, botao, true);
+      botao->releitura = id > 0 ? id : 0;
+    }
+    return;
+  }
+  botoes_conferir(botao, agora);
+}
+
+// Configura os pinos com pull-up e habilita as interrupções de borda
+void botoes_init(const uint *pinos, size_t quantidade, uint32_t debounce_us)
+{
+  tempo_debounce_us = debounce_us;
+  total_botoes = quantidade < BOTOES_MAX ? quantidade : BOTOES_MAX;
+
+  for (size_t i = 0; i < total_botoes; i++)
+  {
+    gpio_init(pinos[i]);
+    gpio_set_dir(pinos[i], GPIO_IN);
+    gpio_pull_up(pinos[i]);
+
+    botoes[i].pino = pinos[i];
+    botoes[i].pressionado = !gpio_get(pinos[i]);
+    botoes[i].ultima_borda_us = time_us_32() - debounce_us;
+    botoes[i].releitura = 0;
+
+    gpio_set_irq_enabled_with_callback(pinos[i], GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE, true, botoes_irq);
+  }
+}
+
+// Retira o evento mais antigo da fila; retorna false se ela estiver vazia
+bool botoes_proximo_evento(botao_evento_t *evento)
+{
+  uint32_t inicio = fila_inicio;
+  if (inicio == fila_fim)
+    return false;
+  __dmb();
+  *evento = fila[inicio % BOTOES_FILA_TAMANHO];
+  __dmb(); // Termina a leitura antes de liberar a posição para a interrupção
+  fila_inicio = inicio + 1;
+  return true;
+}
+
+// Verifica se há eventos na fila, sem retirá-los
+bool botoes_tem_evento(void)
+{
+  return fila_inicio != fila_fim;
+}
@@ -0,0 +1,30 @@
+#ifndef BOTOES_H
+#define BOTOES_H
+
+#include "pico/stdlib.h"
+
+#define BOTOES_MAX 4           // Botões monitorados ao mesmo tempo
+#define BOTOES_FILA_TAMANHO 32 // Eventos na fila (potência de 2)
+
+typedef enum
+{
+  BOTAO_PRESSIONADO,
+  BOTAO_SOLTO
+} botao_tipo_evento_t;
+
+// Evento gerado pela interrupção de um botão
+typedef struct
+{
+  uint8_t pino;
+  uint8_t tipo;         // botao_tipo_evento_t
+  uint32_t instante_us; // Momento da borda que gerou o evento
+} botao_evento_t;
+
+// Eventos descartados porque a fila estava cheia; lido pelas métricas (veja lib/metricas.h)
+extern volatile uint32_t botoes_eventos_perdidos;
+
+void botoes_init(const uint *pinos, size_t quantidade, uint32_t debounce_us);
+bool botoes_proximo_evento(botao_evento_t *evento);
+bool botoes_tem_evento(void);
+
+#endif // BOTOES_H
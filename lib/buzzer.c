@@ -0,0 +1,141 @@
+#include "buzzer.h"
+#include "hardware/pwm.h"
+#include "hardware/clocks.h"
+#include "hardware/sync.h"
+
+// Evento já convertido para os valores que o PWM usa
+typedef struct
+{
+  uint16_t wrap; // 0 = silêncio
+  uint16_t duracao_ms;
+  uint16_t pausa_ms;
+} buzzer_passo_t;
+
+// Notas usadas com frequência: o wrap é calculado uma única vez na inicialização
+static const uint16_t notas_comuns[] = {NOTA_C5, NOTA_E5, NOTA_G5, NOTA_A5};
+static uint16_t wrap_notas_comuns[sizeof(notas_comuns) / sizeof(notas_comuns[0])];
+
+static uint slice_num, channel_num;
+static alarm_pool_t *pool_alarmes; // Os callbacks rodam no núcleo dono deste pool
+
+// Fila circular: buzzer_tocar produz (com interrupções desligadas), o callback do alarme consome.
+// Produtor e alarme precisam estar no mesmo núcleo.
+static buzzer_passo_t fila[BUZZER_FILA_TAMANHO];
+static volatile uint8_t fila_inicio = 0, fila_fim = 0;
+
+static volatile bool ativo = false;   // Há um alarme agendado
+static volatile bool em_pausa = false; // O passo atual já terminou a nota e está na pausa
+static buzzer_passo_t passo_atual;
+
+// Calcula o wrap do PWM para uma frequência
+static uint16_t buzzer_wrap(uint16_t frequencia)
+{
+  if (frequencia == 0)
+    return 0;
+  for (size_t i = 0; i < sizeof(notas_comuns) / sizeof(notas_comuns[0]); i++)
+  {
+    if (notas_comuns[i] == frequencia)
+      return wrap_notas_comuns[i];
+  }
+  uint32_t wrap = BUZZER_CONTADOR_HZ / frequencia - 1;
+  return wrap > 0xFFFF ? 0xFFFF : wrap;
+}
+
+// Inicia o próximo passo da fila; retorna a duração em us (0 = fila vazia)
+static int64_t buzzer_proximo_passo(void)
+{
+  if (fila_inicio == fila_fim)
+  {
+    pwm_set_enabled(slice_num, false);
+    ativo = false;
+    return 0;
+  }
+
+  passo_atual = fila[fila_inicio];
+  fila_inicio = (fila_inicio + 1) % BUZZER_FILA_TAMANHO;
+  em_pausa = false;
+
+  if (passo_atual.wrap)
+  {
+    pwm_set_wrap(slice_num, passo_atual.wrap);
+    pwm_set_chan_level(slice_num, channel_num, passo_atual.wrap / 2); // 50% de duty cycle
+    pwm_set_enabled(slice_num, true);
+  }
+  else
+  {
+    pwm_set_enabled(slice_num, false);
+  }
+  return passo_atual.duracao_ms ? (int64_t)passo_atual.duracao_ms * 1000 : 1;
+}
+
+// Callback do alarme: encerra a nota (ou a pausa) atual e agenda o próximo passo
+static int64_t buzzer_alarme(alarm_id_t id, void *user_data)
+{
+  (void)id;
+  (void)user_data;
+
+  if (!em_pausa && passo_atual.pausa_ms)
+  {
+    pwm_set_enabled(slice_num, false);
+    em_pausa = true;
+    return (int64_t)passo_atual.pausa_ms * 1000;
+  }
+  return buzzer_proximo_passo();
+}
+
+// Inicializa o buzzer e pré-calcula o divisor e os wraps do PWM.
+// 'pool' define em que núcleo o sequenciador roda (NULL = pool padrão).
+void buzzer_init(uint pino, alarm_pool_t *pool)
+{
+  pool_alarmes = pool ? pool : alarm_pool_get_default();
+  gpio_set_function(pino, GPIO_FUNC_PWM);
+  slice_num = pwm_gpio_to_slice_num(pino);
+  channel_num = pwm_gpio_to_channel(pino);
+
+  // O divisor deixa o contador do PWM em BUZZER_CONTADOR_HZ, qualquer que seja o clock
+  pwm_set_clkdiv(slice_num, (float)clock_get_hz(clk_sys) / BUZZER_CONTADOR_HZ);
+  pwm_set_enabled(slice_num, false);
+
+  for (size_t i = 0; i < sizeof(notas_comuns) / sizeof(notas_comuns[0]); i++)
+  {
+    wrap_notas_comuns[i] = BUZZER_CONTADOR_HZ / notas_comuns[i] - 1;
+  }
+}
+
+// Enfileira uma sequência de eventos; retorna false se não couber na fila ou não houver alarme livre
+bool buzzer_tocar(const buzzer_evento_t *eventos, size_t quantidade)
+{
+  uint32_t interrupcoes = save_and_disable_interrupts();
+  size_t livres = (fila_inicio + BUZZER_FILA_TAMANHO - fila_fim - 1) % BUZZER_FILA_TAMANHO;
+  if (quantidade > livres)
+  {
+    restore_interrupts(interrupcoes);
+    return false;
+  }
+
+  for (size_t i = 0; i < quantidade; i++)
+  {
+    buzzer_passo_t *passo = &fila[fila_fim];
+    passo->wrap = buzzer_wrap(eventos[i].frequencia);
+    passo->duracao_ms = eventos[i].duracao_ms;
+    passo->pausa_ms = eventos[i].pausa_ms;
+    fila_fim = (fila_fim + 1) % BUZZER_FILA_TAMANHO;
+  }
+
+  // Se o alarme já terminou a fila anterior, começa a tocar agora. Sem alarme livre no
+  // pool, a sequência é descartada e o buzzer fica parado, pronto para a próxima chamada.
+  if (!ativo)
+  {
+    ativo = true;
+    if (alarm_pool_add_alarm_in_us(pool_alarmes, buzzer_proximo_passo(), buzzer_alarme, NULL, true) < 0)
+    {
+      fila_inicio = fila_fim;
+      pwm_set_enabled(slice_num, false);
+      ativo = false;
+      restore_interrupts(interrupcoes);
+      return false;
+    }
+  }
+  restore_interrupts(interrupcoes);
+  return true;
+}
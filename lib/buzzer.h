@@ -0,0 +1,26 @@
+#ifndef BUZZER_H
+#define BUZZER_H
+
+#include "pico/stdlib.h"
+
+// Frequências das notas musicais (em Hz)
+#define NOTA_C5 523 // Dó5
+#define NOTA_E5 659 // Mi5
+#define NOTA_G5 784 // Sol5
+#define NOTA_A5 880 // Lá5
+
+#define BUZZER_FILA_TAMANHO 32  // Eventos que podem aguardar na fila
+#define BUZZER_CONTADOR_HZ 1000000 // Frequência do contador do PWM após o divisor
+
+// Evento da melodia: toca 'frequencia' por 'duracao_ms' e fica em silêncio por 'pausa_ms'
+typedef struct
+{
+  uint16_t frequencia; // 0 = apenas silêncio
+  uint16_t duracao_ms;
+  uint16_t pausa_ms;
+} buzzer_evento_t;
+
+void buzzer_init(uint pino, alarm_pool_t *pool);
+bool buzzer_tocar(const buzzer_evento_t *eventos, size_t quantidade);
+
+#endif // BUZZER_H
@@ -0,0 +1,80 @@
+#include "console.h"
+#include <string.h>
+
+// Prepara um console vazio com 'paginas' linhas (a altura do display / 8)
+void console_init(console_t *console, uint8_t paginas)
+{
+  fila_spsc_init(&console->fila, console->itens, sizeof(console->itens[0]), CONSOLE_FILA);
+  memset(console->linhas, 0, sizeof(console->linhas));
+  console->paginas = paginas <= SSD1306_MAX_PAGES ? paginas : SSD1306_MAX_PAGES;
+  console->usadas = 0;
+  console->topo = 0;
+  console->sujas = 0;
+  console->completo = false;
+}
+
+// Acrescenta uma linha ao fim do console; retorna false se a fila estiver cheia
+bool console_escrever(console_t *console, const char *texto)
+{
+  console_linha_t linha;
+  strncpy(linha.texto, texto, CONSOLE_COLUNAS);
+  linha.texto[CONSOLE_COLUNAS] = '\0';
+  return fila_spsc_inserir(&console->fila, &linha);
+}
+
+// Passa as linhas da fila para as páginas (no núcleo dono do display). Retorna true se
+// chegou alguma linha. Se chegarem mais linhas que a tela comporta, as primeiras são
+// sobrescritas antes mesmo de serem desenhadas.
+bool console_receber(console_t *console)
+{
+  bool recebeu = false;
+  console_linha_t linha;
+  while (fila_spsc_retirar(&console->fila, &linha))
+  {
+    uint8_t pagina;
+    if (console->usadas < console->paginas)
+    {
+      pagina = console->usadas++;
+    }
+    else
+    {
+      pagina = console->topo; // A mais antiga sai pelo alto
+      console->topo = (console->topo + 1) % console->paginas;
+    }
+    console->linhas[pagina] = linha;
+    console->sujas |= 1u << pagina;
+    recebeu = true;
+  }
+  return recebeu;
+}
+
+// Força o desenho de todas as linhas, por exemplo depois que outra tela cobriu o console
+void console_invalidar(console_t *console)
+{
+  console->completo = false;
+}
+
+static void console_desenhar_pagina(const console_t *console, ssd1306_t *ssd, uint8_t pagina)
+{
+  ssd1306_rect(ssd, 0, pagina * 8, ssd->width, 8, false, true);
+  ssd1306_draw_string_prop(ssd, console->linhas[pagina].texto, 0, pagina * 8);
+}
+
+// Desenha as páginas que mudaram e rola a tela até a linha mais nova. Retorna true se
+// desenhou algo.
+bool console_desenhar(console_t *console, ssd1306_t *ssd)
+{
+  uint8_t sujas = console->completo ? console->sujas : (1u << console->paginas) - 1;
+  if (!sujas)
+    return false;
+
+  for (uint8_t pagina = 0; pagina < console->paginas; pagina++)
+  {
+    if (sujas & (1u << pagina))
+      console_desenhar_pagina(console, ssd, pagina);
+  }
+  ssd1306_set_start_line(ssd, console->topo * 8);
+  console->sujas = 0;
+  console->completo = true;
+  return true;
+}
@@ -0,0 +1,41 @@
+#ifndef CONSOLE_H
+#define CONSOLE_H
+
+#include "ssd1306.h"
+#include "fila_spsc.h"
+
+#define CONSOLE_COLUNAS 31 // Caracteres guardados por linha; o que passar da tela é cortado
+#define CONSOLE_FILA 16    // Linhas à espera de desenho (potência de 2)
+
+// Console de texto com rolagem por hardware. Cada linha de texto ocupa uma página da
+// GDDRAM; com a tela cheia, a linha nova sobrescreve a página da mais antiga e a tela rola
+// pela linha inicial do display (SET_DISP_START_LINE), sem redesenhar as outras linhas.
+// Pelo I2C vão só a página nova e o comando de rolagem.
+//
+// console_escrever pode ser chamado de outro núcleo: as linhas passam por uma fila SPSC e
+// são desenhadas pelo núcleo dono do display. Com a fila cheia, a linha é descartada e
+// contada em fila.descartados; quem escreve nunca espera.
+typedef struct
+{
+  char texto[CONSOLE_COLUNAS + 1];
+} console_linha_t;
+
+typedef struct
+{
+  fila_spsc_t fila;
+  console_linha_t itens[CONSOLE_FILA];
+  console_linha_t linhas[SSD1306_MAX_PAGES]; // Texto de cada página da GDDRAM
+  uint8_t paginas; // Linhas de texto na tela
+  uint8_t usadas;  // Páginas já escritas; a tela rola só depois de cheia
+  uint8_t topo;    // Página exibida no alto da tela
+  uint8_t sujas;   // Bit p: página p mudou desde o último desenho
+  bool completo;   // Todas as linhas já estão no framebuffer
+} console_t;
+
+void console_init(console_t *console, uint8_t paginas);
+bool console_escrever(console_t *console, const char *texto);
+bool console_receber(console_t *console);
+void console_invalidar(console_t *console);
+bool console_desenhar(console_t *console, ssd1306_t *ssd);
+
+#endif // CONSOLE_H
@@ -0,0 +1,92 @@
+#include "credenciais.h"
+#include <string.h>
+
+#define ROTL(x, b) (uint64_t)(((x) << (b)) | ((x) >> (64 - (b))))
+
+// Lê 8 bytes em little-endian, sem exigir alinhamento
+static uint64_t ler_u64(const uint8_t *p)
+{
+  uint64_t valor = 0;
+  for (int i = 7; i >= 0; i--)
+    valor = (valor << 8) | p[i];
+  return valor;
+}
+
+static void sipround(uint64_t v[4])
+{
+  v[0] += v[1];
+  v[1] = ROTL(v[1], 13);
+  v[1] ^= v[0];
+  v[0] = ROTL(v[0], 32);
+  v[2] += v[3];
+  v[3] = ROTL(v[3], 16);
+  v[3] ^= v[2];
+  v[0] += v[3];
+  v[3] = ROTL(v[3], 21);
+  v[3] ^= v[0];
+  v[2] += v[1];
+  v[1] = ROTL(v[1], 17);
+  v[1] ^= v[2];
+  v[2] = ROTL(v[2], 32);
+}
+
+// SipHash-2-4 com saída de 64 bits
+uint64_t credenciais_hash(const uint8_t chave[16], const void *dados, size_t tamanho)
+{
+  const uint8_t *m = dados;
+  uint64_t k0 = ler_u64(chave);
+  uint64_t k1 = ler_u64(chave + 8);
+  uint64_t v[4] = {k0 ^ 0x736f6d6570736575ull, k1 ^ 0x646f72616e646f6dull, k0 ^ 0x6c7967656e657261ull,
+                   k1 ^ 0x7465646279746573ull};
+
+  size_t inteiros = tamanho & ~(size_t)7;
+  for (size_t i = 0; i < inteiros; i += 8)
+  {
+    uint64_t bloco = ler_u64(m + i);
+    v[3] ^= bloco;
+    sipround(v);
+    sipround(v);
+    v[0] ^= bloco;
+  }
+
+  // Último bloco: bytes restantes e o tamanho no byte mais alto
+  uint64_t bloco = (uint64_t)tamanho << 56;
+  for (size_t i = inteiros; i < tamanho; i++)
+    bloco |= (uint64_t)m[i] << (8 * (i - inteiros));
+  v[3] ^= bloco;
+  sipround(v);
+  sipround(v);
+  v[0] ^= bloco;
+
+  v[2] ^= 0xff;
+  for (int i = 0; i < 4; i++)
+    sipround(v);
+  return v[0] ^ v[1] ^ v[2] ^ v[3];
+}
+
+// Procura a senha na tabela; se encontrar, informa o usuário dono dela.
+// A busca binária não tem desvios dependentes da senha (o número de passos depende só do
+// tamanho da tabela) e o hash encontrado é comparado em tempo constante.
+bool credenciais_verificar(const credenciais_tabela_t *tabela, const char *senha, uint32_t *usuario)
+{
+  if (tabela->total == 0)
+    return false;
+
+  uint64_t hash = credenciais_hash(tabela->chave, senha, strlen(senha));
+
+  // Ao final, base aponta para a última entrada com hash <= hash procurado (ou a primeira)
+  const credencial_t *base = tabela->entradas;
+  uint32_t restantes = tabela->total;
+  while (restantes > 1)
+  {
+    uint32_t metade = restantes / 2;
+    base = (base[metade].hash <= hash) ? &base[metade] : base;
+    restantes -= metade;
+  }
+
+  uint64_t diferenca = base->hash ^ hash;
+  bool encontrada = ((diferenca | (0 - diferenca)) >> 63) == 0; // Sem comparação com desvio
+  if (encontrada && usuario)
+    *usuario = base->usuario;
+  return encontrada;
+}
@@ -0,0 +1,30 @@
+#ifndef CREDENCIAIS_H
+#define CREDENCIAIS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Credencial gravada na flash: hash da senha e o usuário dono dela
+typedef struct
+{
+  uint64_t hash;    // SipHash-2-4 da senha com a chave da tabela
+  uint32_t usuario; // Identificador do usuário
+} credencial_t;
+
+// Tabela gerada por ferramentas/gerar_credenciais.py: ordenada por hash, sem hashes repetidos.
+// A chave é o sal da tabela, sorteada a cada geração; sem ela os hashes não servem para
+// montar um dicionário de senhas fora da placa.
+typedef struct
+{
+  uint8_t chave[16];
+  uint32_t total;
+  const credencial_t *entradas;
+} credenciais_tabela_t;
+
+extern const credenciais_tabela_t credenciais; // Definida no arquivo gerado (lib/credenciais_tabela.c)
+
+uint64_t credenciais_hash(const uint8_t chave[16], const void *dados, size_t tamanho);
+bool credenciais_verificar(const credenciais_tabela_t *tabela, const char *senha, uint32_t *usuario);
+
+#endif // CREDENCIAIS_H
@@ -0,0 +1,16 @@
+// Gerado por ferramentas/gerar_credenciais.py; não edite.
+#include "credenciais.h"
+
+static const credencial_t entradas[] = {
+    {0x17a12c2f3b318038ull, 3u},
+    {0x3ff6c5fc200bcb60ull, 2u},
+    {0x50790312ca85dc7bull, 5u},
+    {0x725ee0158188c3fcull, 1u},
+    {0xa47b996eca07581cull, 4u},
+};
+
+const credenciais_tabela_t credenciais = {
+    .chave = {0xae, 0x8a, 0xb9, 0x49, 0xb7, 0xe7, 0x71, 0x74, 0x78, 0x50, 0x54, 0x4b, 0x7d, 0x27, 0x66, 0x21},
+    .total = 5,
+    .entradas = entradas,
+};
@@ -0,0 +1,49 @@
+#include "fila_spsc.h"
+#include "hardware/sync.h"
+#include <string.h>
+
+// Prepara a fila sobre um vetor de 'capacidade' itens fornecido pelo chamador
+void fila_spsc_init(fila_spsc_t *fila, void *itens, size_t tamanho_item, uint32_t capacidade)
+{
+  fila->itens = itens;
+  fila->tamanho_item = tamanho_item;
+  fila->capacidade = capacidade;
+  fila->inicio = 0;
+  fila->fim = 0;
+  fila->descartados = 0;
+}
+
+// Copia o item para a fila; retorna false (sem esperar) se ela estiver cheia
+bool fila_spsc_inserir(fila_spsc_t *fila, const void *item)
+{
+  uint32_t fim = fila->fim;
+  if (fim - fila->inicio >= fila->capacidade)
+  {
+    fila->descartados++;
+    return false;
+  }
+  memcpy(&fila->itens[(fim & (fila->capacidade - 1)) * fila->tamanho_item], item, fila->tamanho_item);
+  __dmb(); // O item precisa estar completo antes de o outro núcleo ver o novo 'fim'
+  fila->fim = fim + 1;
+  __sev(); // Acorda o consumidor se ele estiver em __wfe()
+  return true;
+}
+
+// Copia o item mais antigo para 'item'; retorna false se a fila estiver vazia
+bool fila_spsc_retirar(fila_spsc_t *fila, void *item)
+{
+  uint32_t inicio = fila->inicio;
+  if (inicio == fila->fim)
+    return false;
+  __dmb();
+  memcpy(item, &fila->itens[(inicio & (fila->capacidade - 1)) * fila->tamanho_item], fila->tamanho_item);
+  __dmb(); // Termina a cópia antes de liberar a posição para o produtor
+  fila->inicio = inicio + 1;
+  return true;
+}
+
+// Verifica se não há itens na fila
+bool fila_spsc_vazia(const fila_spsc_t *fila)
+{
+  return fila->inicio == fila->fim;
+}
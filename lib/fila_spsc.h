@@ -0,0 +1,23 @@
+#ifndef FILA_SPSC_H
+#define FILA_SPSC_H
+
+#include "pico/stdlib.h"
+
+// Fila circular de itens de tamanho fixo para um produtor e um consumidor,
+// que podem estar em núcleos diferentes. Não usa travas nem desliga interrupções.
+typedef struct
+{
+  uint8_t *itens;
+  size_t tamanho_item;
+  uint32_t capacidade;         // Potência de 2
+  volatile uint32_t inicio;    // Alterado só pelo consumidor
+  volatile uint32_t fim;       // Alterado só pelo produtor
+  volatile uint32_t descartados; // Itens recusados porque a fila estava cheia
+} fila_spsc_t;
+
+void fila_spsc_init(fila_spsc_t *fila, void *itens, size_t tamanho_item, uint32_t capacidade);
+bool fila_spsc_inserir(fila_spsc_t *fila, const void *item);
+bool fila_spsc_retirar(fila_spsc_t *fila, void *item);
+bool fila_spsc_vazia(const fila_spsc_t *fila);
+
+#endif // FILA_SPSC_H
@@ -1,18 +1,48 @@
 
-// Fontes para A-Z e 0-9. Os caracteres tem 8x8 pixels
+// Fonte 8x8 com todos os caracteres ASCII imprimíveis, de ' ' (0x20) a '~' (0x7E), na
+// ordem da tabela ASCII: o glifo de c começa em font[(c - FONT_FIRST) * FONT_WIDTH].
+// Cada byte é uma coluna, com o bit 0 na linha de cima.
 
-static uint8_t font[] = {
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // Nothing
-    0x3e, 0x41, 0x41, 0x49, 0x41, 0x41, 0x3e, 0x00, // 0 ?
-    0x00, 0x00, 0x42, 0x7f, 0x40, 0x00, 0x00, 0x00, // 1 /
-    0x30, 0x49, 0x49, 0x49, 0x49, 0x46, 0x00, 0x00, // 2 *
-    0x49, 0x49, 0x49, 0x49, 0x49, 0x49, 0x36, 0x00, // 3 &
-    0x3f, 0x20, 0x20, 0x78, 0x20, 0x20, 0x00, 0x00, // 4 ¨
-    0x4f, 0x49, 0x49, 0x49, 0x49, 0x30, 0x00, 0x00, // 5 %
-    0x3f, 0x48, 0x48, 0x48, 0x48, 0x48, 0x30, 0x00, // 6 $
-    0x01, 0x01, 0x01, 0x61, 0x31, 0x0d, 0x03, 0x00, // 7 #
-    0x36, 0x49, 0x49, 0x49, 0x49, 0x49, 0x36, 0x00, // 8 @
-    0x06, 0x09, 0x09, 0x09, 0x09, 0x09, 0x7f, 0x00, // 9 !
+#define FONT_FIRST ' '
+#define FONT_LAST '~'
+#define FONT_GLYPHS (FONT_LAST - FONT_FIRST + 1)
+#define FONT_WIDTH 8  // Avanço da fonte monoespaçada
+#define FONT_HEIGHT 8
+
+static const uint8_t font[FONT_GLYPHS * FONT_WIDTH] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // espaço
+    0x00, 0x00, 0x00, 0x5f, 0x00, 0x00, 0x00, 0x00, // !
+    0x00, 0x00, 0x03, 0x00, 0x03, 0x00, 0x00, 0x00, // "
+    0x00, 0x14, 0x7f, 0x14, 0x7f, 0x14, 0x00, 0x00, // #
+    0x00, 0x24, 0x2a, 0x7f, 0x2a, 0x12, 0x00, 0x00, // $
+    0x23, 0x13, 0x08, 0x04, 0x62, 0x61, 0x00, 0x00, // %
+    0x36, 0x49, 0x55, 0x22, 0x20, 0x50, 0x00, 0x00, // &
+    0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, // '
+    0x00, 0x00, 0x3e, 0x41, 0x00, 0x00, 0x00, 0x00, // (
+    0x00, 0x00, 0x41, 0x3e, 0x00, 0x00, 0x00, 0x00, // )
+    0x00, 0x14, 0x08, 0x3e, 0x08, 0x14, 0x00, 0x00, // *
+    0x00, 0x08, 0x08, 0x3e, 0x08, 0x08, 0x00, 0x00, // +
+    0x00, 0x00, 0x40, 0x20, 0x00, 0x00, 0x00, 0x00, // ,
+    0x00, 0x08, 0x08, 0x08, 0x08, 0x00, 0x00, 0x00, // -
+    0x00, 0x00, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, // .
+    0x00, 0x40, 0x30, 0x08, 0x06, 0x01, 0x00, 0x00, // /
+    0x3e, 0x41, 0x41, 0x49, 0x41, 0x41, 0x3e, 0x00, // 0
+    0x00, 0x00, 0x42, 0x7f, 0x40, 0x00, 0x00, 0x00, // 1
+    0x30, 0x49, 0x49, 0x49, 0x49, 0x46, 0x00, 0x00, // 2
+    0x49, 0x49, 0x49, 0x49, 0x49, 0x49, 0x36, 0x00, // 3
+    0x3f, 0x20, 0x20, 0x78, 0x20, 0x20, 0x00, 0x00, // 4
+    0x4f, 0x49, 0x49, 0x49, 0x49, 0x30, 0x00, 0x00, // 5
+    0x3f, 0x48, 0x48, 0x48, 0x48, 0x48, 0x30, 0x00, // 6
+    0x01, 0x01, 0x01, 0x61, 0x31, 0x0d, 0x03, 0x00, // 7
+    0x36, 0x49, 0x49, 0x49, 0x49, 0x49, 0x36, 0x00, // 8
+    0x06, 0x09, 0x09, 0x09, 0x09, 0x09, 0x7f, 0x00, // 9
+    0x00, 0x00, 0x00, 0x22, 0x00, 0x00, 0x00, 0x00, // :
+    0x00, 0x00, 0x40, 0x22, 0x00, 0x00, 0x00, 0x00, // ;
+    0x00, 0x08, 0x14, 0x22, 0x41, 0x00, 0x00, 0x00, // <
+    0x00, 0x14, 0x14, 0x14, 0x14, 0x00, 0x00, 0x00, // =
+    0x00, 0x41, 0x22, 0x14, 0x08, 0x00, 0x00, 0x00, // >
+    0x00, 0x02, 0x01, 0x51, 0x09, 0x06, 0x00, 0x00, // ?
+    0x3e, 0x41, 0x5d, 0x55, 0x59, 0x1e, 0x00, 0x00, // @
     0x78, 0x14, 0x12, 0x11, 0x12, 0x14, 0x78, 0x00, // A
     0x7f, 0x49, 0x49, 0x49, 0x49, 0x49, 0x7f, 0x00, // B
     0x7e, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x00, // C
@@ -39,6 +69,12 @@ static uint8_t font[] = {
     0x00, 0x41, 0x22, 0x14, 0x14, 0x22, 0x41, 0x00, // X
     0x01, 0x02, 0x04, 0x78, 0x04, 0x02, 0x01, 0x00, // Y
     0x41, 0x61, 0x59, 0x45, 0x43, 0x41, 0x00, 0x00, // Z
+    0x00, 0x00, 0x7f, 0x41, 0x00, 0x00, 0x00, 0x00, // [
+    0x00, 0x01, 0x06, 0x08, 0x30, 0x40, 0x00, 0x00, // \\ (barra invertida)
+    0x00, 0x00, 0x41, 0x7f, 0x00, 0x00, 0x00, 0x00, // ]
+    0x00, 0x04, 0x02, 0x01, 0x02, 0x04, 0x00, 0x00, // ^
+    0x00, 0x40, 0x40, 0x40, 0x40, 0x40, 0x00, 0x00, // _
+    0x00, 0x00, 0x01, 0x02, 0x00, 0x00, 0x00, 0x00, // `
     0x20, 0x54, 0x54, 0x54, 0x78, 0x00, 0x00, 0x00, // a
     0x7e, 0x48, 0x48, 0x48, 0x30, 0x00, 0x00, 0x00, // b
     0x38, 0x44, 0x44, 0x44, 0x44, 0x00, 0x00, 0x00, // c
@@ -65,4 +101,28 @@ static uint8_t font[] = {
     0x44, 0x28, 0x10, 0x28, 0x44, 0x00, 0x00, 0x00, // x
     0x1c, 0xa0, 0xa0, 0xa0, 0x7c, 0x00, 0x00, 0x00, // y
     0x44, 0x64, 0x54, 0x4c, 0x44, 0x00, 0x00, 0x00, // z
-};
\ No newline at end of file
+    0x00, 0x00, 0x08, 0x36, 0x41, 0x00, 0x00, 0x00, // {
+    0x00, 0x00, 0x00, 0x7f, 0x00, 0x00, 0x00, 0x00, // |
+    0x00, 0x00, 0x41, 0x36, 0x08, 0x00, 0x00, 0x00, // }
+    0x00, 0x08, 0x04, 0x08, 0x08, 0x04, 0x00, 0x00, // ~
+};
+
+// Para o texto proporcional: primeira coluna com pixels acesos e largura de cada glifo
+// (o espaço, sem pixels, ocupa 3 colunas). Entre dois glifos fica uma coluna vazia.
+static const uint8_t font_first_col[FONT_GLYPHS] = {
+    0, 3, 2, 1, 1, 0, 0, 3, 2, 2, 1, 1, 2, 1, 3, 1,
+    0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 3, 2, 1, 1, 1, 1,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 3, 0, 1, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 2, 1, 2, 1, 1,
+    2, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 0, 2, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 3, 2, 1,
+};
+
+static const uint8_t font_widths[FONT_GLYPHS] = {
+    3, 1, 3, 5, 5, 6, 6, 1, 2, 2, 5, 5, 2, 4, 1, 5,
+    7, 3, 6, 7, 6, 6, 7, 7, 7, 7, 1, 2, 4, 4, 4, 5,
+    6, 7, 7, 7, 7, 7, 7, 7, 7, 1, 7, 6, 7, 7, 7, 7,
+    7, 7, 7, 6, 7, 7, 7, 7, 6, 7, 6, 2, 5, 2, 5, 5,
+    2, 5, 5, 5, 5, 5, 5, 5, 5, 3, 4, 5, 3, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 3, 1, 3, 5,
+};
@@ -0,0 +1,10 @@
+// Gerado por ferramentas/gerar_imagens.py; não edite.
+#ifndef IMAGENS_H
+#define IMAGENS_H
+
+#include "ssd1306.h"
+
+extern const ssd1306_image_t imagem_cadeado_fechado;
+extern const ssd1306_image_t imagem_cadeado_aberto;
+
+#endif // IMAGENS_H
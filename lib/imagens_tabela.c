@@ -0,0 +1,22 @@
+// Gerado por ferramentas/gerar_imagens.py; não edite.
+#include "imagens.h"
+
+// cadeado_fechado.pbm: 32x32, 57 bytes (128 sem compressão)
+static const uint8_t dados_cadeado_fechado[] = {
+    0x86, 0x00, 0x05, 0xc0, 0xe0, 0xf0, 0xf8, 0xf8, 0x7c, 0x82, 0x3c, 0x05, 0x7c, 0xf8, 0xf8, 0xf0,
+    0xe0, 0xc0, 0x8c, 0x00, 0x01, 0x80, 0xfc, 0x82, 0xff, 0x86, 0xc0, 0x82, 0xff, 0x01, 0xfc, 0x80,
+    0x8a, 0x00, 0x86, 0xff, 0x03, 0x8f, 0x07, 0x07, 0x8f, 0x86, 0xff, 0x8a, 0x00, 0x00, 0x7f, 0x86,
+    0xff, 0x80, 0xf0, 0x86, 0xff, 0x00, 0x7f, 0x84, 0x00,
+};
+
+const ssd1306_image_t imagem_cadeado_fechado = {32, 32, sizeof(dados_cadeado_fechado), dados_cadeado_fechado};
+
+// cadeado_aberto.pbm: 32x32, 57 bytes (128 sem compressão)
+static const uint8_t dados_cadeado_aberto[] = {
+    0x86, 0x00, 0x05, 0xe0, 0xf0, 0xf8, 0xfc, 0x7c, 0x3e, 0x82, 0x1e, 0x05, 0x3e, 0x7c, 0xfc, 0xf8,
+    0xf0, 0xe0, 0x8c, 0x00, 0x01, 0x80, 0xfe, 0x82, 0xff, 0x86, 0xc0, 0x82, 0xc7, 0x01, 0xc6, 0x80,
+    0x8a, 0x00, 0x86, 0xff, 0x03, 0x8f, 0x07, 0x07, 0x8f, 0x86, 0xff, 0x8a, 0x00, 0x00, 0x7f, 0x86,
+    0xff, 0x80, 0xf0, 0x86, 0xff, 0x00, 0x7f, 0x84, 0x00,
+};
+
+const ssd1306_image_t imagem_cadeado_aberto = {32, 32, sizeof(dados_cadeado_aberto), dados_cadeado_aberto};
@@ -0,0 +1,186 @@
+#include "joystick.h"
+#include "hardware/adc.h"
+#include "hardware/dma.h"
+
+#define JOYSTICK_PRIMEIRO_PINO_ADC 26 // GPIO do canal 0 do ADC
+#define JOYSTICK_CLOCK_ADC_HZ 48000000
+#define JOYSTICK_DIVISOR_MAX 65535.0f // Maior parte inteira do divisor do ADC (16 bits)
+
+// Buffer circular preenchido pelo DMA: índices pares = canal menor, ímpares = canal maior.
+// O alinhamento é exigido pelo modo de anel do DMA.
+static uint16_t amostras[JOYSTICK_AMOSTRAS] __attribute__((aligned(JOYSTICK_AMOSTRAS * sizeof(uint16_t))));
+
+static int canal_dados, canal_controle;
+static uint32_t contagem_recarga = 0xFFFFFFFF; // Recarregada pelo canal de controle a cada volta
+
+static uint8_t paridade_x, paridade_y; // Posição (0 ou 1) de cada eixo no par intercalado
+static joystick_eixo_t eixo_x = {JOYSTICK_CENTRO_PADRAO, 0};
+static joystick_eixo_t eixo_y = {JOYSTICK_CENTRO_PADRAO, 0};
+
+static joystick_filtro_t filtro_atual = JOYSTICK_FILTRO_MEDIA;
+static uint8_t janela_atual = 8;
+static uint8_t alfa_atual = 64; // Peso da amostra nova na EMA (Q8: 64 = 0,25)
+static uint32_t atraso_enchimento_ms; // Tempo para o buffer receber uma janela completa
+
+// Copia as últimas 'janela' amostras de um eixo, da mais antiga para a mais nova
+static void joystick_copiar_janela(uint8_t paridade, uint16_t *destino, uint8_t janela)
+{
+  uintptr_t escrita = (uintptr_t)dma_channel_hw_addr(canal_dados)->write_addr;
+  uint32_t proxima = (escrita - (uintptr_t)amostras) / sizeof(uint16_t);
+
+  // Última amostra completa do eixo: o índice com a paridade certa antes da posição de escrita
+  uint32_t indice = (proxima + JOYSTICK_AMOSTRAS - 1) % JOYSTICK_AMOSTRAS;
+  if ((indice & 1) != paridade)
+    indice = (indice + JOYSTICK_AMOSTRAS - 1) % JOYSTICK_AMOSTRAS;
+
+  for (int i = janela - 1; i >= 0; i--)
+  {
+    destino[i] = amostras[indice];
+    indice = (indice + JOYSTICK_AMOSTRAS - 2) % JOYSTICK_AMOSTRAS;
+  }
+}
+
+// Aplica o filtro configurado à janela mais recente de um eixo
+static uint16_t joystick_filtrar(uint8_t paridade)
+{
+  uint16_t janela[JOYSTICK_JANELA_MAX];
+  joystick_copiar_janela(paridade, janela, janela_atual);
+
+  switch (filtro_atual)
+  {
+  case JOYSTICK_FILTRO_MEDIANA:
+  {
+    // Ordenação por inserção: a janela é pequena
+    for (uint8_t i = 1; i < janela_atual; i++)
+    {
+      uint16_t valor = janela[i];
+      int j = i - 1;
+      while (j >= 0 && janela[j] > valor)
+      {
+        janela[j + 1] = janela[j];
+        j--;
+      }
+      janela[j + 1] = valor;
+    }
+    return janela[janela_atual / 2];
+  }
+
+  case JOYSTICK_FILTRO_EMA:
+  {
+    int32_t ema = janela[0] << 8; // Q8
+    for (uint8_t i = 1; i < janela_atual; i++)
+    {
+      ema += ((((int32_t)janela[i] << 8) - ema) * alfa_atual) >> 8;
+    }
+    return (uint16_t)((ema + 128) >> 8);
+  }
+
+  default:
+  {
+    uint32_t soma = 0;
+    for (uint8_t i = 0; i < janela_atual; i++)
+    {
+      soma += janela[i];
+    }
+    return (uint16_t)(soma / janela_atual);
+  }
+  }
+}
+
+// Converte a leitura filtrada em deslocamento do centro, zerando a zona morta
+static int16_t joystick_deslocamento(uint16_t valor, const joystick_eixo_t *eixo)
+{
+  int16_t deslocamento = (int16_t)valor - (int16_t)eixo->centro;
+  if (deslocamento <= (int16_t)eixo->zona_morta && deslocamento >= -(int16_t)eixo->zona_morta)
+    return 0;
+  return deslocamento;
+}
+
+// Inicia a amostragem contínua dos dois eixos: o ADC alterna entre os canais (round-robin)
+// e o DMA grava cada conversão no buffer circular, sem participação da CPU
+void joystick_init(uint pino_x, uint pino_y, uint32_t taxa_hz)
+{
+  uint canal_x = pino_x - JOYSTICK_PRIMEIRO_PINO_ADC;
+  uint canal_y = pino_y - JOYSTICK_PRIMEIRO_PINO_ADC;
+  paridade_x = canal_x > canal_y;
+  paridade_y = canal_y > canal_x;
+
+  adc_init();
+  adc_gpio_init(pino_x);
+  adc_gpio_init(pino_y);
+  adc_select_input(canal_x < canal_y ? canal_x : canal_y); // O round-robin começa pelo canal menor
+  adc_set_round_robin((1u << canal_x) | (1u << canal_y));
+  adc_fifo_setup(true, true, 1, false, false); // FIFO com DREQ a cada amostra, 12 bits
+
+  canal_dados = dma_claim_unused_channel(true);
+  canal_controle = dma_claim_unused_channel(true);
+
+  // Canal de dados: FIFO do ADC -> buffer circular
+  dma_channel_config c = dma_channel_get_default_config(canal_dados);
+  channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+  channel_config_set_read_increment(&c, false);
+  channel_config_set_write_increment(&c, true);
+  channel_config_set_ring(&c, true, __builtin_ctz(sizeof(amostras)));
+  channel_config_set_dreq(&c, DREQ_ADC);
+  channel_config_set_chain_to(&c, canal_controle);
+  dma_channel_configure(canal_dados, &c, amostras, &adc_hw->fifo, contagem_recarga, false);
+
+  // Canal de controle: ao fim da contagem, recarrega e redispara o canal de dados
+  dma_channel_config controle = dma_channel_get_default_config(canal_controle);
+  channel_config_set_transfer_data_size(&controle, DMA_SIZE_32);
+  channel_config_set_read_increment(&controle, false);
+  channel_config_set_write_increment(&controle, false);
+  dma_channel_configure(canal_controle, &controle, &dma_channel_hw_addr(canal_dados)->al1_transfer_count_trig,
+                        &contagem_recarga, 1, false);
+
+  joystick_definir_taxa(taxa_hz);
+  dma_channel_start(canal_dados);
+  adc_run(true);
+}
+
+// Muda a taxa de amostragem de cada eixo, inclusive com a amostragem em andamento (por
+// exemplo, mais lenta com o sistema ocioso). Taxas abaixo de JOYSTICK_TAXA_MIN_HZ ficam
+// nesse mínimo, o limite do divisor do ADC.
+void joystick_definir_taxa(uint32_t taxa_hz)
+{
+  float divisor = (float)JOYSTICK_CLOCK_ADC_HZ / (taxa_hz * 2) - 1; // Duas conversões por leitura
+  if (divisor > JOYSTICK_DIVISOR_MAX)
+    divisor = JOYSTICK_DIVISOR_MAX;
+  adc_set_clkdiv(divisor);
+  atraso_enchimento_ms = (uint32_t)(JOYSTICK_JANELA_MAX * 2 * 1000 * (divisor + 1) / JOYSTICK_CLOCK_ADC_HZ) + 1;
+}
+
+// Escolhe o filtro, o tamanho da janela (amostras por eixo) e o peso da EMA (Q8)
+void joystick_configurar_filtro(joystick_filtro_t filtro, uint8_t janela, uint8_t alfa_q8)
+{
+  if (janela < 1)
+    janela = 1;
+  if (janela > JOYSTICK_JANELA_MAX)
+    janela = JOYSTICK_JANELA_MAX;
+  filtro_atual = filtro;
+  janela_atual = janela;
+  alfa_atual = alfa_q8;
+}
+
+// Mede o centro de cada eixo (joystick em repouso) e define as zonas mortas
+void joystick_calibrar(uint16_t zona_morta_x, uint16_t zona_morta_y)
+{
+  sleep_ms(atraso_enchimento_ms); // Garante uma janela completa de amostras
+
+  joystick_filtro_t filtro = filtro_atual;
+  uint8_t janela = janela_atual;
+  joystick_configurar_filtro(JOYSTICK_FILTRO_MEDIA, JOYSTICK_JANELA_MAX, alfa_atual);
+  eixo_x.centro = joystick_filtrar(paridade_x);
+  eixo_y.centro = joystick_filtrar(paridade_y);
+  joystick_configurar_filtro(filtro, janela, alfa_atual);
+
+  eixo_x.zona_morta = zona_morta_x;
+  eixo_y.zona_morta = zona_morta_y;
+}
+
+// Leitura filtrada e calibrada: deslocamento de cada eixo em relação ao centro (0 = repouso)
+void joystick_ler(int16_t *x, int16_t *y)
+{
+  *x = joystick_deslocamento(joystick_filtrar(paridade_x), &eixo_x);
+  *y = joystick_deslocamento(joystick_filtrar(paridade_y), &eixo_y);
+}
@@ -0,0 +1,31 @@
+#ifndef JOYSTICK_H
+#define JOYSTICK_H
+
+#include "pico/stdlib.h"
+
+#define JOYSTICK_AMOSTRAS 64       // Tamanho do buffer circular (amostras dos dois eixos intercaladas)
+#define JOYSTICK_JANELA_MAX 16     // Maior janela do filtro, em amostras por eixo
+#define JOYSTICK_CENTRO_PADRAO 2048 // Centro nominal do ADC de 12 bits
+#define JOYSTICK_TAXA_MIN_HZ 366    // Menor taxa por eixo: 48 MHz / (2 conversões * divisor máximo de 65536)
+
+typedef enum
+{
+  JOYSTICK_FILTRO_MEDIA,   // Média móvel da janela
+  JOYSTICK_FILTRO_MEDIANA, // Mediana da janela (descarta picos)
+  JOYSTICK_FILTRO_EMA      // Média móvel exponencial sobre a janela
+} joystick_filtro_t;
+
+// Calibração de um eixo
+typedef struct
+{
+  uint16_t centro;     // Leitura com o joystick em repouso
+  uint16_t zona_morta; // Desvio máximo do centro tratado como repouso
+} joystick_eixo_t;
+
+void joystick_init(uint pino_x, uint pino_y, uint32_t taxa_hz);
+void joystick_definir_taxa(uint32_t taxa_hz);
+void joystick_configurar_filtro(joystick_filtro_t filtro, uint8_t janela, uint8_t alfa_q8);
+void joystick_calibrar(uint16_t zona_morta_x, uint16_t zona_morta_y);
+void joystick_ler(int16_t *x, int16_t *y);
+
+#endif // JOYSTICK_H
@@ -0,0 +1,152 @@
+#include "matriz_led.h"
+#include "ws2812.pio.h"
+#include "hardware/dma.h"
+#include <string.h>
+
+#define MATRIZ_FREQ_HZ 800000
+#define MATRIZ_TEMPO_QUADRO_US (MATRIZ_LEDS * 24 * 125 / 100) // 24 bits de 1,25 us por LED
+#define MATRIZ_TEMPO_RESET_US 60                                 // Nível baixo que encerra o quadro
+
+// Correção gama (2,2): converte a intensidade desejada no valor que o LED precisa receber
+static const uint8_t gama[256] = {
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   1,
+      1,   1,   1,   1,   1,   1,   1,   1,   1,   2,   2,   2,   2,   2,   2,   2,
+      3,   3,   3,   3,   3,   4,   4,   4,   4,   5,   5,   5,   5,   6,   6,   6,
+      6,   7,   7,   7,   8,   8,   8,   9,   9,   9,  10,  10,  11,  11,  11,  12,
+     12,  13,  13,  13,  14,  14,  15,  15,  16,  16,  17,  17,  18,  18,  19,  19,
+     20,  20,  21,  22,  22,  23,  23,  24,  25,  25,  26,  26,  27,  28,  28,  29,
+     30,  30,  31,  32,  33,  33,  34,  35,  35,  36,  37,  38,  39,  39,  40,  41,
+     42,  43,  43,  44,  45,  46,  47,  48,  49,  49,  50,  51,  52,  53,  54,  55,
+     56,  57,  58,  59,  60,  61,  62,  63,  64,  65,  66,  67,  68,  69,  70,  71,
+     73,  74,  75,  76,  77,  78,  79,  81,  82,  83,  84,  85,  87,  88,  89,  90,
+     91,  93,  94,  95,  97,  98,  99, 100, 102, 103, 105, 106, 107, 109, 110, 111,
+    113, 114, 116, 117, 119, 120, 121, 123, 124, 126, 127, 129, 130, 132, 133, 135,
+    137, 138, 140, 141, 143, 145, 146, 148, 149, 151, 153, 154, 156, 158, 159, 161,
+    163, 165, 166, 168, 170, 172, 173, 175, 177, 179, 181, 182, 184, 186, 188, 190,
+    192, 194, 196, 197, 199, 201, 203, 205, 207, 209, 211, 213, 215, 217, 219, 221,
+    223, 225, 227, 229, 231, 234, 236, 238, 240, 242, 244, 246, 248, 251, 253, 255,
+};
+
+// Gama combinada com o brilho atual; refeita só quando o brilho muda
+static uint8_t tabela_brilho[256];
+
+static uint32_t pixels[MATRIZ_LEDS];  // Framebuffer em 0xRRGGBB, na ordem física dos LEDs
+static uint32_t palavras[MATRIZ_LEDS]; // Quadro em transmissão: GRB alinhado à esquerda para o PIO
+
+static PIO pio_matriz;
+static uint sm_matriz;
+static int canal_dma;
+static uint64_t liberada_em_us = 0; // Momento em que o último quadro termina (com o reset)
+static bool pendente = false;       // Houve atualização pedida enquanto a matriz estava ocupada
+
+// Posição física do LED (x, y) na matriz em zigue-zague, com (0, 0) no canto superior esquerdo
+static inline uint8_t matriz_indice(uint8_t x, uint8_t y)
+{
+  uint8_t linha = MATRIZ_ALTURA - 1 - y; // A cadeia começa na linha de baixo
+  if (linha % 2 == 0)
+    return linha * MATRIZ_LARGURA + (MATRIZ_LARGURA - 1 - x);
+  return linha * MATRIZ_LARGURA + x;
+}
+
+// Inicializa o PIO, o canal de DMA e as tabelas de cor
+void matriz_init(PIO pio, uint sm, uint pino)
+{
+  pio_matriz = pio;
+  sm_matriz = sm;
+  uint offset = pio_add_program(pio, &ws2812_program);
+  ws2812_program_init(pio, sm, offset, pino, MATRIZ_FREQ_HZ, false);
+
+  canal_dma = dma_claim_unused_channel(true);
+  dma_channel_config c = dma_channel_get_default_config(canal_dma);
+  channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+  channel_config_set_read_increment(&c, true);
+  channel_config_set_write_increment(&c, false);
+  channel_config_set_dreq(&c, pio_get_dreq(pio, sm, true));
+  dma_channel_configure(canal_dma, &c, &pio->txf[sm], palavras, MATRIZ_LEDS, false);
+
+  matriz_definir_brilho(MATRIZ_BRILHO_PADRAO);
+  memset(pixels, 0, sizeof(pixels));
+}
+
+// Define o brilho global (0-255) recalculando a tabela de conversão
+void matriz_definir_brilho(uint8_t brilho)
+{
+  for (uint16_t i = 0; i < 256; i++)
+  {
+    tabela_brilho[i] = (gama[i] * brilho + 127) / 255;
+  }
+}
+
+// Define a cor de um LED
+void matriz_pixel(uint8_t x, uint8_t y, uint32_t cor)
+{
+  if (x >= MATRIZ_LARGURA || y >= MATRIZ_ALTURA)
+    return; // Verifica limites
+  pixels[matriz_indice(x, y)] = cor;
+}
+
+// Define a mesma cor para todos os LEDs
+void matriz_preencher(uint32_t cor)
+{
+  for (uint8_t i = 0; i < MATRIZ_LEDS; i++)
+  {
+    pixels[i] = cor;
+  }
+}
+
+// Desenha um ícone de 5x5 (bit 4 de cada linha = coluna 0) com cor de frente e de fundo
+void matriz_desenhar_icone(const uint8_t linhas[MATRIZ_ALTURA], uint32_t cor, uint32_t fundo)
+{
+  for (uint8_t y = 0; y < MATRIZ_ALTURA; y++)
+  {
+    for (uint8_t x = 0; x < MATRIZ_LARGURA; x++)
+    {
+      bool aceso = linhas[y] & (1u << (MATRIZ_LARGURA - 1 - x));
+      pixels[matriz_indice(x, y)] = aceso ? cor : fundo;
+    }
+  }
+}
+
+// Verifica se o quadro anterior ainda está sendo transmitido
+bool matriz_ocupada(void)
+{
+  return dma_channel_is_busy(canal_dma) || time_us_64() < liberada_em_us;
+}
+
+// Converte o framebuffer e dispara o envio por DMA. Se o quadro anterior não terminou,
+// retorna false e o envio fica pendente para matriz_processar()
+bool matriz_atualizar(void)
+{
+  if (matriz_ocupada())
+  {
+    pendente = true;
+    return false;
+  }
+  pendente = false;
+
+  for (uint8_t i = 0; i < MATRIZ_LEDS; i++)
+  {
+    uint32_t cor = pixels[i];
+    uint8_t r = tabela_brilho[(cor >> 16) & 0xFF];
+    uint8_t g = tabela_brilho[(cor >> 8) & 0xFF];
+    uint8_t b = tabela_brilho[cor & 0xFF];
+    palavras[i] = ((uint32_t)g << 24) | ((uint32_t)r << 16) | ((uint32_t)b << 8);
+  }
+
+  dma_channel_set_read_addr(canal_dma, palavras, true);
+  liberada_em_us = time_us_64() + MATRIZ_TEMPO_QUADRO_US + MATRIZ_TEMPO_RESET_US;
+  return true;
+}
+
+// Verifica se há uma atualização esperando a matriz ficar livre
+bool matriz_pendente(void)
+{
+  return pendente;
+}
+
+// Envia a atualização que ficou pendente, se a matriz já estiver livre
+void matriz_processar(void)
+{
+  if (pendente)
+    matriz_atualizar();
+}
@@ -0,0 +1,29 @@
+#ifndef MATRIZ_LED_H
+#define MATRIZ_LED_H
+
+#include "pico/stdlib.h"
+#include "hardware/pio.h"
+
+#define MATRIZ_LARGURA 5
+#define MATRIZ_ALTURA 5
+#define MATRIZ_LEDS (MATRIZ_LARGURA * MATRIZ_ALTURA)
+
+#define MATRIZ_BRILHO_PADRAO 128 // 50% de intensidade
+
+// Cores no formato 0xRRGGBB
+#define MATRIZ_PRETO 0x000000
+#define MATRIZ_VERMELHO 0xFF0000
+#define MATRIZ_VERDE 0x00FF00
+#define MATRIZ_AZUL 0x0000FF
+
+void matriz_init(PIO pio, uint sm, uint pino);
+void matriz_definir_brilho(uint8_t brilho);
+void matriz_pixel(uint8_t x, uint8_t y, uint32_t cor);
+void matriz_preencher(uint32_t cor);
+void matriz_desenhar_icone(const uint8_t linhas[MATRIZ_ALTURA], uint32_t cor, uint32_t fundo);
+bool matriz_atualizar(void);
+bool matriz_ocupada(void);
+bool matriz_pendente(void);
+void matriz_processar(void);
+
+#endif // MATRIZ_LED_H
@@ -0,0 +1,147 @@
+#include "metricas.h"
+#include <stdio.h>
+#include <string.h>
+
+metricas_trilha_t metricas_trilhas[2];
+
+// Contadores não são copiados: o registro guarda o endereço da variável de quem conta
+static struct
+{
+  const char *nome;
+  const volatile uint32_t *valor;
+} contadores[METRICAS_CONTADORES_MAX];
+static uint8_t total_contadores = 0;
+
+static metricas_histograma_t *histogramas[METRICAS_HISTOGRAMAS_MAX];
+static uint8_t total_histogramas = 0;
+
+static const char *const *nomes_eventos;
+static uint8_t total_nomes_eventos = 0;
+
+// Guarda os nomes dos tipos de evento usados na impressão da trilha
+void metricas_init(const char *const *nomes, uint8_t total)
+{
+  nomes_eventos = nomes;
+  total_nomes_eventos = total;
+}
+
+// Registra um contador existente; o valor é lido só na impressão
+void metricas_contador(const char *nome, const volatile uint32_t *valor)
+{
+  if (total_contadores < METRICAS_CONTADORES_MAX)
+  {
+    contadores[total_contadores].nome = nome;
+    contadores[total_contadores].valor = valor;
+    total_contadores++;
+  }
+}
+
+static void metricas_limpar_histograma(metricas_histograma_t *histograma)
+{
+  const char *nome = histograma->nome;
+  uint8_t nucleo = histograma->nucleo;
+  memset(histograma, 0, sizeof(*histograma));
+  histograma->nome = nome;
+  histograma->nucleo = nucleo;
+  histograma->minimo = UINT32_MAX;
+}
+
+// Prepara e registra um histograma alimentado pelo núcleo 'nucleo'
+void metricas_histograma(metricas_histograma_t *histograma, const char *nome, uint8_t nucleo)
+{
+  histograma->nome = nome;
+  histograma->nucleo = nucleo;
+  metricas_limpar_histograma(histograma);
+  if (total_histogramas < METRICAS_HISTOGRAMAS_MAX)
+    histogramas[total_histogramas++] = histograma;
+}
+
+static void metricas_imprimir_trilha(const metricas_trilha_t *trilha)
+{
+  uint32_t fim = trilha->proximo;
+  uint32_t inicio = fim > METRICAS_TRILHA_TAMANHO ? fim - METRICAS_TRILHA_TAMANHO : 0;
+  for (uint32_t i = inicio; i != fim; i++)
+  {
+    const metricas_evento_t *evento = &trilha->eventos[i & (METRICAS_TRILHA_TAMANHO - 1)];
+    if (evento->tipo < total_nomes_eventos)
+      printf("evento %lu %u %s %u\n", (unsigned long)evento->instante_us, evento->nucleo, nomes_eventos[evento->tipo],
+             evento->argumento);
+    else
+      printf("evento %lu %u %u %u\n", (unsigned long)evento->instante_us, evento->nucleo, evento->tipo,
+             evento->argumento);
+  }
+}
+
+// Imprime tudo no formato de linhas:
+//   metricas <instante_us>
+//   contador <nome> <valor>
+//   histograma <nome> <contagem> <soma> <mínimo> <máximo> <balde0,balde1,...> <p99>
+//   evento <instante_us> <núcleo> <tipo> <argumento>
+//   fim
+// A leitura não pausa quem escreve: um evento gravado durante a impressão pode sair incompleto.
+void metricas_imprimir(void)
+{
+  printf("metricas %lu\n", (unsigned long)time_us_32());
+
+  for (uint8_t i = 0; i < total_contadores; i++)
+    printf("contador %s %lu\n", contadores[i].nome, (unsigned long)*contadores[i].valor);
+
+  for (uint8_t i = 0; i < total_histogramas; i++)
+  {
+    const metricas_histograma_t *h = histogramas[i];
+    printf("histograma %s %lu %lu %lu %lu ", h->nome, (unsigned long)h->contagem, (unsigned long)h->soma,
+           (unsigned long)(h->contagem ? h->minimo : 0), (unsigned long)h->maximo);
+    for (uint8_t b = 0; b < METRICAS_BALDES; b++)
+      printf(b ? ",%lu" : "%lu", (unsigned long)h->baldes[b]);
+    printf(" %lu\n", (unsigned long)metricas_percentil(h, 99));
+  }
+
+  metricas_imprimir_trilha(&metricas_trilhas[0]);
+  metricas_imprimir_trilha(&metricas_trilhas[1]);
+  printf("fim\n");
+}
+
+// Estima o percentil (1 a 100) pelo limite superior do balde em que ele cai, sem passar
+// do máximo medido. Com baldes logarítmicos, o erro é de no máximo 2x.
+uint32_t metricas_percentil(const metricas_histograma_t *histograma, uint8_t percentual)
+{
+  if (!histograma->contagem)
+    return 0;
+
+  uint32_t alvo = (uint32_t)(((uint64_t)histograma->contagem * percentual + 99) / 100);
+  uint32_t acumulado = 0;
+  for (uint8_t b = 0; b < METRICAS_BALDES - 1; b++)
+  {
+    acumulado += histograma->baldes[b];
+    if (acumulado >= alvo)
+    {
+      uint32_t limite = b ? (1u << b) - 1 : 0;
+      return limite < histograma->maximo ? limite : histograma->maximo;
+    }
+  }
+  return histograma->maximo;
+}
+
+// Zera os histogramas e a trilha do núcleo atual; os contadores pertencem a quem os
+// registrou. Cada núcleo precisa chamar a sua vez (o outro pode estar medindo).
+void metricas_zerar(void)
+{
+  uint nucleo = get_core_num();
+  for (uint8_t i = 0; i < total_histogramas; i++)
+  {
+    if (histogramas[i]->nucleo == nucleo)
+      metricas_limpar_histograma(histogramas[i]);
+  }
+  memset(&metricas_trilhas[nucleo], 0, sizeof(metricas_trilhas[nucleo]));
+}
+
+// Atende um caractere recebido pela serial/USB: 'm' imprime as métricas. Retorna false se
+// o caractere não for um comando das métricas. Zerar ('z') fica com a aplicação, que
+// precisa pedir a cada núcleo que chame metricas_zerar.
+bool metricas_atender(int caractere)
+{
+  if (caractere != 'm')
+    return false;
+  metricas_imprimir();
+  return true;
+}
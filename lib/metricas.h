@@ -0,0 +1,78 @@
+#ifndef METRICAS_H
+#define METRICAS_H
+
+#include "pico/stdlib.h"
+
+#define METRICAS_CONTADORES_MAX 24
+#define METRICAS_HISTOGRAMAS_MAX 8
+#define METRICAS_BALDES 16          // Balde i: valores em [2^(i-1), 2^i); o último acumula o resto
+#define METRICAS_TRILHA_TAMANHO 128 // Eventos guardados por núcleo (potência de 2)
+
+// Distribuição de uma medida em microssegundos, em baldes logarítmicos
+typedef struct
+{
+  const char *nome;
+  uint8_t nucleo; // Núcleo que alimenta o histograma e o zera
+  uint32_t contagem;
+  uint32_t soma;
+  uint32_t minimo;
+  uint32_t maximo;
+  uint32_t baldes[METRICAS_BALDES];
+} metricas_histograma_t;
+
+// Evento da trilha: quando, em que núcleo, qual tipo e um argumento livre
+typedef struct
+{
+  uint32_t instante_us;
+  uint8_t tipo;
+  uint8_t nucleo;
+  uint16_t argumento;
+} metricas_evento_t;
+
+// Trilha circular de um núcleo; os eventos mais antigos são sobrescritos
+typedef struct
+{
+  uint32_t proximo;
+  metricas_evento_t eventos[METRICAS_TRILHA_TAMANHO];
+} metricas_trilha_t;
+
+extern metricas_trilha_t metricas_trilhas[2];
+
+void metricas_init(const char *const *nomes_eventos, uint8_t total_eventos);
+void metricas_contador(const char *nome, const volatile uint32_t *valor);
+void metricas_histograma(metricas_histograma_t *histograma, const char *nome, uint8_t nucleo);
+void metricas_imprimir(void);
+void metricas_zerar(void);
+bool metricas_atender(int caractere);
+uint32_t metricas_percentil(const metricas_histograma_t *histograma, uint8_t percentual);
+
+// Registra uma medida. Cada histograma deve ser alimentado só pelo núcleo informado em
+// metricas_histograma, que é também quem o zera.
+static inline void metricas_medir(metricas_histograma_t *h, uint32_t valor)
+{
+  uint32_t balde = valor ? 32 - __builtin_clz(valor) : 0;
+  if (balde >= METRICAS_BALDES)
+    balde = METRICAS_BALDES - 1;
+  h->baldes[balde]++;
+  h->contagem++;
+  h->soma += valor;
+  if (valor < h->minimo)
+    h->minimo = valor;
+  if (valor > h->maximo)
+    h->maximo = valor;
+}
+
+// Acrescenta um evento à trilha do núcleo atual (fora de interrupções)
+static inline void metricas_evento(uint8_t tipo, uint16_t argumento)
+{
+  uint nucleo = get_core_num();
+  metricas_trilha_t *trilha = &metricas_trilhas[nucleo];
+  metricas_evento_t *evento = &trilha->eventos[trilha->proximo & (METRICAS_TRILHA_TAMANHO - 1)];
+  evento->instante_us = time_us_32();
+  evento->tipo = tipo;
+  evento->nucleo = (uint8_t)nucleo;
+  evento->argumento = argumento;
+  trilha->proximo++;
+}
+
+#endif // METRICAS_H
@@ -0,0 +1,67 @@
+#include "ritmo.h"
+
+// Prepara o ritmo com a taxa alvo; o histograma deve ser registrado nas métricas por quem usa
+void ritmo_init(ritmo_t *ritmo, uint32_t fps)
+{
+  ritmo_definir_fps(ritmo, fps);
+  ritmo->proximo_us = time_us_32();
+  ritmo->pendente = false;
+  ritmo->em_andamento = false;
+  ritmo->quadros = 0;
+  ritmo->atrasados = 0;
+}
+
+// Muda a taxa alvo; vale a partir da próxima janela
+void ritmo_definir_fps(ritmo_t *ritmo, uint32_t fps)
+{
+  ritmo->intervalo_us = 1000000 / (fps ? fps : 1);
+}
+
+// Indica que o estado mudou e a tela precisa de um novo quadro
+void ritmo_marcar(ritmo_t *ritmo)
+{
+  ritmo->pendente = true;
+}
+
+// Retorna true se um quadro deve ser desenhado agora: há mudanças, o quadro anterior já
+// está na tela e a janela do próximo chegou. Nesse caso o quadro começa e a janela avança.
+bool ritmo_iniciar_quadro(ritmo_t *ritmo, uint32_t agora_us)
+{
+  if (!ritmo->pendente || ritmo->em_andamento || (int32_t)(agora_us - ritmo->proximo_us) < 0)
+    return false;
+
+  // Parado por mais de uma janela, o ritmo recomeça agora em vez de tentar recuperar quadros
+  ritmo->proximo_us += ritmo->intervalo_us;
+  if ((int32_t)(agora_us - ritmo->proximo_us) >= 0)
+    ritmo->proximo_us = agora_us + ritmo->intervalo_us;
+
+  ritmo->inicio_us = agora_us;
+  ritmo->pendente = false;
+  ritmo->em_andamento = true;
+  return true;
+}
+
+// Indica que o quadro em andamento terminou de ser enviado
+void ritmo_quadro_exibido(ritmo_t *ritmo, uint32_t agora_us)
+{
+  if (!ritmo->em_andamento)
+    return;
+
+  uint32_t tempo_us = agora_us - ritmo->inicio_us;
+  metricas_medir(&ritmo->tempos, tempo_us);
+  ritmo->quadros++;
+  if (tempo_us > ritmo->intervalo_us)
+    ritmo->atrasados++;
+  ritmo->em_andamento = false;
+}
+
+// Retorna true se há um quadro pendente esperando a janela; 'espera_us' recebe o tempo até ela
+bool ritmo_espera_us(const ritmo_t *ritmo, uint32_t agora_us, uint32_t *espera_us)
+{
+  if (!ritmo->pendente || ritmo->em_andamento)
+    return false;
+
+  int32_t falta = (int32_t)(ritmo->proximo_us - agora_us);
+  *espera_us = falta > 0 ? (uint32_t)falta : 0;
+  return true;
+}
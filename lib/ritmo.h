@@ -0,0 +1,32 @@
+#ifndef RITMO_H
+#define RITMO_H
+
+#include "pico/stdlib.h"
+#include "metricas.h"
+
+#define RITMO_FPS_PADRAO 30
+
+// Ritmo de quadros do display: as mudanças de estado que chegam entre dois quadros viram
+// um único quadro, os quadros não passam da taxa alvo e, sem mudanças, nenhum quadro é
+// gerado. Depois de um tempo parado, a primeira mudança é desenhada na hora; a demora de
+// uma mudança até a tela fica limitada a um intervalo mais o envio.
+typedef struct
+{
+  uint32_t intervalo_us; // 1 s / quadros por segundo
+  uint32_t proximo_us;   // Início da próxima janela de quadro
+  uint32_t inicio_us;    // Início do quadro em andamento; o prazo é inicio_us + intervalo_us
+  bool pendente;         // Há mudança ainda não desenhada
+  bool em_andamento;     // Quadro desenhado e ainda não inteiro na tela
+  metricas_histograma_t tempos; // Do início do quadro até ele estar na tela
+  uint32_t quadros;   // Quadros exibidos
+  uint32_t atrasados; // Quadros que chegaram à tela depois do prazo
+} ritmo_t;
+
+void ritmo_init(ritmo_t *ritmo, uint32_t fps);
+void ritmo_definir_fps(ritmo_t *ritmo, uint32_t fps);
+void ritmo_marcar(ritmo_t *ritmo);
+bool ritmo_iniciar_quadro(ritmo_t *ritmo, uint32_t agora_us);
+void ritmo_quadro_exibido(ritmo_t *ritmo, uint32_t agora_us);
+bool ritmo_espera_us(const ritmo_t *ritmo, uint32_t agora_us, uint32_t *espera_us);
+
+#endif // RITMO_H
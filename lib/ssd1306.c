@@ -2,111 +2,579 @@
 #include "font.h"
 #include <string.h>
 
-// Inicializa o display OLED
+// Geometria usada pelas primitivas: constantes com SSD1306_FIXED_GEOMETRY, campos do ssd1306_t sem ele
+#ifdef SSD1306_FIXED_GEOMETRY
+#define SSD_WIDTH(ssd) SSD1306_FIXED_WIDTH
+#define SSD_HEIGHT(ssd) SSD1306_FIXED_HEIGHT
+#define SSD_PAGES(ssd) (SSD1306_FIXED_HEIGHT / 8)
+#define SSD_BUFSIZE(ssd) SSD1306_FIXED_BUFSIZE
+#else
+#define SSD_WIDTH(ssd) ((ssd)->width)
+#define SSD_HEIGHT(ssd) ((ssd)->height)
+#define SSD_PAGES(ssd) ((ssd)->pages)
+#define SSD_BUFSIZE(ssd) ((ssd)->bufsize)
+#endif
+
+// Painéis mais estreitos que os 128 segmentos do controlador usam as colunas do meio (64x48: 32 a 95)
+#define SSD_COL_OFFSET(ssd) ((128 - SSD_WIDTH(ssd)) / 2)
+
+// Marca as colunas x0..x1 das páginas page0..page1 como alteradas
+static inline void ssd1306_mark_dirty(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t page0, uint8_t page1)
+{
+  for (uint8_t page = page0; page <= page1; page++)
+  {
+    if (x0 < ssd->dirty_x0[page])
+      ssd->dirty_x0[page] = x0;
+    if (x1 > ssd->dirty_x1[page])
+      ssd->dirty_x1[page] = x1;
+  }
+}
+
+// Marca todas as páginas como limpas
+static inline void ssd1306_clear_dirty(ssd1306_t *ssd)
+{
+  memset(ssd->dirty_x0, 0xFF, sizeof(ssd->dirty_x0));
+  memset(ssd->dirty_x1, 0x00, sizeof(ssd->dirty_x1));
+}
+
+// Painel que transmite por DMA em cada barramento I2C (NULL = barramento livre). Painéis
+// no mesmo barramento se revezam; barramentos diferentes transmitem ao mesmo tempo.
+static ssd1306_t *bus_owner[2];
+
+static inline ssd1306_t **ssd1306_bus_slot(const ssd1306_t *ssd)
+{
+  return &bus_owner[i2c_hw_index(ssd->i2c_port)];
+}
+
+// Verifica se outro painel ainda transmite pelo barramento deste
+static bool ssd1306_bus_busy(ssd1306_t *ssd)
+{
+  ssd1306_t *owner = *ssd1306_bus_slot(ssd);
+  return owner && owner != ssd && ssd1306_flush_busy(owner);
+}
+
+// Aguarda o fim da transferência por DMA em andamento no barramento deste painel
+static void ssd1306_bus_wait(ssd1306_t *ssd)
+{
+  ssd1306_t *owner = *ssd1306_bus_slot(ssd);
+  if (owner)
+    ssd1306_flush_wait(owner);
+}
+
+// Escreve no barramento I2C contabilizando os bytes enviados
+static inline void ssd1306_write(ssd1306_t *ssd, const uint8_t *data, size_t len)
+{
+  ssd1306_bus_wait(ssd); // Não intercala com uma transferência por DMA em andamento
+  i2c_write_blocking(ssd->i2c_port, ssd->address, data, len, false);
+  ssd->bytes_sent += len;
+}
+
+// Acrescenta um byte ao fluxo de transmissão (last = gera STOP após o byte)
+static inline void ssd1306_stream_put(ssd1306_t *ssd, uint8_t byte, bool last)
+{
+  ssd->tx_stream[ssd->tx_len++] = byte | (last ? I2C_IC_DATA_CMD_STOP_BITS : 0);
+  ssd->tx_transactions += last;
+}
+
+// Acrescenta ao fluxo a janela x0..x1 / page0..page1 e os dados correspondentes
+static void ssd1306_stream_window(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t page0, uint8_t page1)
+{
+  // Define a janela numa única transação de comandos
+  ssd1306_stream_put(ssd, 0x00, false); // Co = 0, D/C = 0 (comandos)
+  ssd1306_stream_put(ssd, SET_COL_ADDR, false);
+  ssd1306_stream_put(ssd, x0 + SSD_COL_OFFSET(ssd), false);
+  ssd1306_stream_put(ssd, x1 + SSD_COL_OFFSET(ssd), false);
+  ssd1306_stream_put(ssd, SET_PAGE_ADDR, false);
+  ssd1306_stream_put(ssd, page0, false);
+  ssd1306_stream_put(ssd, page1, true);
+
+  ssd1306_stream_put(ssd, 0x40, false); // Co = 0, D/C = 1 (dados)
+  for (uint8_t page = page0; page <= page1; page++)
+  {
+    uint16_t index = page * SSD_WIDTH(ssd) + x0;
+    for (uint16_t x = x0; x <= x1; x++, index++)
+    {
+      uint8_t byte = ssd->ram_buffer[1 + index];
+      ssd->shadow_buffer[index] = byte;
+      ssd1306_stream_put(ssd, byte, page == page1 && x == x1);
+    }
+  }
+}
+
+// Inicializa o display OLED. Com SSD1306_FIXED_GEOMETRY, width e height são ignorados.
 void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c)
 {
+#ifdef SSD1306_FIXED_GEOMETRY
+  (void)width;
+  (void)height;
+  ssd->width = SSD1306_FIXED_WIDTH;
+  ssd->height = SSD1306_FIXED_HEIGHT;
+  ssd->pages = SSD1306_FIXED_HEIGHT / 8;
+  ssd->bufsize = SSD1306_FIXED_BUFSIZE;
+  memset(ssd->ram_buffer, 0, sizeof(ssd->ram_buffer));
+  memset(ssd->shadow_buffer, 0, sizeof(ssd->shadow_buffer));
+  ssd->tx_capacity = sizeof(ssd->tx_stream) / sizeof(ssd->tx_stream[0]);
+#else
   ssd->width = width;
   ssd->height = height;
   ssd->pages = height / 8U;
+  ssd->bufsize = ssd->pages * ssd->width + 1;
+  ssd->ram_buffer = calloc(ssd->bufsize, sizeof(uint8_t));
+  ssd->shadow_buffer = calloc(ssd->bufsize - 1, sizeof(uint8_t));
+  ssd->tx_capacity = ssd->bufsize + SSD1306_WINDOW_OVERHEAD + SSD1306_START_LINE_OVERHEAD;
+  ssd->tx_stream = calloc(ssd->tx_capacity, sizeof(uint16_t));
+#endif
   ssd->address = address;
   ssd->i2c_port = i2c;
   ssd->external_vcc = external_vcc;
-  ssd->bufsize = ssd->pages * ssd->width + 1;
-  ssd->ram_buffer = calloc(ssd->bufsize, sizeof(uint8_t));
   ssd->ram_buffer[0] = 0x40;  // Co = 0, D/C = 1 (dados)
   ssd->port_buffer[0] = 0x80; // Co = 1, D/C = 0 (comando)
+  ssd->tx_len = 0;
+  ssd->tx_transactions = 0;
+  ssd->start_line = 0;
+  ssd->start_line_dirty = false;
+  ssd->dma_channel = dma_claim_unused_channel(true);
+  ssd->flushing = false;
+  ssd->bytes_sent = 0;
+  ssd->frames_sent = 0;
+  ssd->tx_errors = 0;
+  ssd1306_invalidate(ssd);
 }
 
 // Envia um comando para o display
 void ssd1306_command(ssd1306_t *ssd, uint8_t command)
 {
   ssd->port_buffer[1] = command;
-  i2c_write_blocking(ssd->i2c_port, ssd->address, ssd->port_buffer, 2, false);
+  ssd1306_write(ssd, ssd->port_buffer, 2);
+}
+
+// Inicia uma lista de comandos (Co = 0, D/C = 0: todos os bytes seguintes são comandos)
+void ssd1306_cmdlist_begin(ssd1306_cmdlist_t *list)
+{
+  list->buf[0] = 0x00;
+  list->len = 1;
+}
+
+// Acrescenta um comando (ou argumento) à lista
+void ssd1306_cmdlist_add(ssd1306_cmdlist_t *list, uint8_t command)
+{
+  if (list->len < sizeof(list->buf))
+    list->buf[list->len++] = command;
+}
+
+// Envia todos os comandos da lista numa única transação I2C
+void ssd1306_cmdlist_send(ssd1306_t *ssd, const ssd1306_cmdlist_t *list)
+{
+  if (list->len > 1)
+    ssd1306_write(ssd, list->buf, list->len);
+}
+
+// Força o reenvio completo do buffer no próximo envio
+void ssd1306_invalidate(ssd1306_t *ssd)
+{
+  ssd->shadow_valid = false;
+  ssd1306_clear_dirty(ssd);
+  ssd1306_mark_dirty(ssd, 0, SSD_WIDTH(ssd) - 1, 0, SSD_PAGES(ssd) - 1);
 }
 
-// Envia os dados do buffer para o display
+// Monta no fluxo de transmissão apenas as regiões do buffer que mudaram
+static void ssd1306_encode_changes(ssd1306_t *ssd)
+{
+  ssd->tx_len = 0;
+  ssd->tx_transactions = 0;
+  for (uint8_t page = 0; page < SSD_PAGES(ssd); page++)
+  {
+    uint16_t x = ssd->dirty_x0[page];
+    uint16_t end = ssd->dirty_x1[page];
+    const uint8_t *novo = &ssd->ram_buffer[1 + page * SSD_WIDTH(ssd)];
+    const uint8_t *atual = &ssd->shadow_buffer[page * SSD_WIDTH(ssd)];
+
+    // Percorre a faixa suja comparando com o que já está no display
+    while (x <= end)
+    {
+      while (x <= end && novo[x] == atual[x])
+        x++;
+      if (x > end)
+        break;
+
+      // Junta diferenças próximas numa só janela quando abrir outra custaria mais
+      uint16_t first = x, last = x;
+      while (x <= end && x - last <= SSD1306_WINDOW_OVERHEAD)
+      {
+        if (novo[x] != atual[x])
+          last = x;
+        x++;
+      }
+
+      // Sem espaço no fluxo: mais barato reenviar o quadro inteiro
+      if (ssd->tx_len + SSD1306_WINDOW_OVERHEAD + (last - first + 1) >
+          ssd->tx_capacity - SSD1306_START_LINE_OVERHEAD)
+      {
+        ssd->tx_len = 0;
+        ssd->tx_transactions = 0;
+        ssd1306_stream_window(ssd, 0, SSD_WIDTH(ssd) - 1, 0, SSD_PAGES(ssd) - 1);
+        return;
+      }
+      ssd1306_stream_window(ssd, first, last, page, page);
+    }
+  }
+}
+
+// Verifica se o buffer tem alterações ainda não enviadas ao display
+bool ssd1306_has_changes(const ssd1306_t *ssd)
+{
+  if (!ssd->shadow_valid || ssd->start_line_dirty)
+    return true;
+  for (uint8_t page = 0; page < SSD_PAGES(ssd); page++)
+  {
+    if (ssd->dirty_x0[page] <= ssd->dirty_x1[page])
+      return true;
+  }
+  return false;
+}
+
+// Inicia o envio assíncrono (por DMA) das alterações do buffer para o display.
+// Retorna false se a transferência anterior deste painel, ou a de outro painel no mesmo
+// barramento, ainda estiver em andamento.
+bool ssd1306_flush_start(ssd1306_t *ssd)
+{
+  if (ssd1306_flush_busy(ssd) || ssd1306_bus_busy(ssd))
+    return false;
+
+  // O fluxo guarda o quadro já convertido: ram_buffer fica livre para o próximo desenho
+  if (ssd->shadow_valid)
+  {
+    ssd1306_encode_changes(ssd);
+  }
+  else
+  {
+    ssd->tx_len = 0;
+    ssd->tx_transactions = 0;
+    ssd1306_stream_window(ssd, 0, SSD_WIDTH(ssd) - 1, 0, SSD_PAGES(ssd) - 1);
+    ssd->shadow_valid = true;
+  }
+  ssd1306_clear_dirty(ssd);
+
+  // A linha inicial muda depois dos dados: a rolagem só aparece com a página nova já gravada
+  if (ssd->start_line_dirty)
+  {
+    ssd1306_stream_put(ssd, 0x00, false); // Co = 0, D/C = 0 (comandos)
+    ssd1306_stream_put(ssd, SET_DISP_START_LINE | ssd->start_line, true);
+    ssd->start_line_dirty = false;
+  }
+
+  if (ssd->tx_len == 0)
+    return true; // Nada mudou
+
+  i2c_hw_t *hw = i2c_get_hw(ssd->i2c_port);
+  hw->enable = 0;
+  hw->tar = ssd->address;
+  hw->enable = 1;
+
+  dma_channel_config c = dma_channel_get_default_config(ssd->dma_channel);
+  channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+  channel_config_set_read_increment(&c, true);
+  channel_config_set_write_increment(&c, false);
+  channel_config_set_dreq(&c, i2c_get_dreq(ssd->i2c_port, true));
+  *ssd1306_bus_slot(ssd) = ssd;
+  dma_channel_configure(ssd->dma_channel, &c, &hw->data_cmd, ssd->tx_stream, ssd->tx_len, true);
+
+  ssd->bytes_sent += ssd->tx_len;
+  ssd->frames_sent++;
+  ssd->flushing = true;
+  return true;
+}
+
+// Bits que o envio em andamento (ou o último) ocupa no barramento: em cada transação,
+// start, endereço e dados com o ACK (9 bits por byte) e stop. Dividido pela frequência do
+// I2C, dá a duração prevista do envio.
+uint32_t ssd1306_flush_bits(const ssd1306_t *ssd)
+{
+  return 9 * (ssd->tx_len + ssd->tx_transactions) + 2 * ssd->tx_transactions;
+}
+
+// Verifica se ainda há uma transferência por DMA em andamento
+bool ssd1306_flush_busy(ssd1306_t *ssd)
+{
+  if (!ssd->flushing)
+    return false;
+
+  i2c_hw_t *hw = i2c_get_hw(ssd->i2c_port);
+  if (dma_channel_is_busy(ssd->dma_channel) || !(hw->status & I2C_IC_STATUS_TFE_BITS) ||
+      (hw->status & I2C_IC_STATUS_MST_ACTIVITY_BITS))
+  {
+    // Em caso de NACK o controlador descarta a FIFO e a transferência não tem como concluir
+    if (!(hw->raw_intr_stat & I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS))
+      return true;
+    dma_channel_abort(ssd->dma_channel);
+  }
+
+  if (hw->raw_intr_stat & I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS)
+  {
+    (void)hw->clr_tx_abrt;
+    ssd->tx_errors++;
+    ssd1306_invalidate(ssd); // O conteúdo do display ficou incerto
+  }
+  ssd->flushing = false;
+  if (*ssd1306_bus_slot(ssd) == ssd)
+    *ssd1306_bus_slot(ssd) = NULL;
+  return false;
+}
+
+// Aguarda o fim da transferência por DMA em andamento
+void ssd1306_flush_wait(ssd1306_t *ssd)
+{
+  while (ssd1306_flush_busy(ssd))
+    tight_loop_contents();
+}
+
+// Envia as alterações do buffer para o display e aguarda a conclusão
 void ssd1306_send_data(ssd1306_t *ssd)
 {
-  ssd1306_command(ssd, SET_COL_ADDR);
-  ssd1306_command(ssd, 0);
-  ssd1306_command(ssd, ssd->width - 1);
-  ssd1306_command(ssd, SET_PAGE_ADDR);
-  ssd1306_command(ssd, 0);
-  ssd1306_command(ssd, ssd->pages - 1);
-  i2c_write_blocking(ssd->i2c_port, ssd->address, ssd->ram_buffer, ssd->bufsize, false);
+  ssd1306_bus_wait(ssd);
+  ssd1306_flush_start(ssd);
+  ssd1306_flush_wait(ssd);
+}
+
+// Rola a imagem: a linha 'line' da GDDRAM passa a ser a do alto da tela. A mudança vai no
+// próximo envio, depois dos dados, e custa dois bytes em vez do quadro inteiro. O buffer e
+// as primitivas de desenho continuam nas coordenadas da GDDRAM.
+void ssd1306_set_start_line(ssd1306_t *ssd, uint8_t line)
+{
+  line %= SSD_HEIGHT(ssd);
+  if (line == ssd->start_line)
+    return;
+  ssd->start_line = line;
+  ssd->start_line_dirty = true;
+}
+
+// Prepara um agendador sem painéis
+void ssd1306_scheduler_init(ssd1306_scheduler_t *sched)
+{
+  sched->count = 0;
+  sched->next = 0;
+  sched->flushing = 0;
+}
+
+// Acrescenta um painel já inicializado; retorna false se não houver espaço
+bool ssd1306_scheduler_add(ssd1306_scheduler_t *sched, ssd1306_t *ssd)
+{
+  if (sched->count == SSD1306_SCHEDULER_MAX)
+    return false;
+  sched->panels[sched->count++] = ssd;
+  return true;
+}
+
+// Avança os envios sem bloquear: conclui as transferências terminadas e, em cada barramento
+// livre, inicia o envio do próximo painel com alterações. A vez de começar roda entre os
+// painéis a cada chamada, para que um painel que muda sempre não monopolize o barramento.
+// Retorna os painéis (bit i = panels[i]) cujo envio terminou; em 'started', os que começaram.
+uint32_t ssd1306_scheduler_poll(ssd1306_scheduler_t *sched, uint32_t *started)
+{
+  uint32_t finished = 0;
+  *started = 0;
+  for (uint8_t i = 0; i < sched->count; i++)
+  {
+    uint32_t bit = 1u << i;
+    if ((sched->flushing & bit) && !ssd1306_flush_busy(sched->panels[i]))
+    {
+      sched->flushing &= ~bit;
+      finished |= bit;
+    }
+  }
+
+  for (uint8_t k = 0; k < sched->count; k++)
+  {
+    uint8_t i = (sched->next + k) % sched->count;
+    uint32_t bit = 1u << i;
+    ssd1306_t *ssd = sched->panels[i];
+    if ((sched->flushing & bit) || !ssd1306_has_changes(ssd))
+      continue;
+    if (ssd1306_flush_start(ssd) && ssd->flushing)
+    {
+      sched->flushing |= bit;
+      *started |= bit;
+    }
+  }
+  if (sched->count)
+    sched->next = (sched->next + 1) % sched->count;
+  return finished;
 }
 
-// Configura o display OLED
+// Configura o display OLED com uma única transação de comandos
 void ssd1306_config(ssd1306_t *ssd)
 {
-  ssd1306_command(ssd, SET_DISP | 0x00);                 // Desliga o display
-  ssd1306_command(ssd, SET_MEM_ADDR);                    // Configura o modo de endereçamento de memória
-  ssd1306_command(ssd, 0x00);                            // Modo horizontal
-  ssd1306_command(ssd, SET_DISP_START_LINE | 0x00);      // Define a linha inicial do display
-  ssd1306_command(ssd, SET_SEG_REMAP | 0x01);            // Mapeamento de segmentos (inverte colunas)
-  ssd1306_command(ssd, SET_MUX_RATIO);                   // Configura a proporção do multiplexador
-  ssd1306_command(ssd, HEIGHT - 1);                      // Altura do display - 1
-  ssd1306_command(ssd, SET_COM_OUT_DIR | 0x08);          // Define a direção dos pinos COM
-  ssd1306_command(ssd, SET_DISP_OFFSET);                 // Define o deslocamento do display
-  ssd1306_command(ssd, 0x00);                            // Sem deslocamento
-  ssd1306_command(ssd, SET_COM_PIN_CFG);                 // Configura os pinos COM
-  ssd1306_command(ssd, 0x12);                            // Configuração padrão para OLED 128x64
-  ssd1306_command(ssd, SET_DISP_CLK_DIV);                // Configura o divisor de clock
-  ssd1306_command(ssd, 0x80);                            // Frequência padrão
-  ssd1306_command(ssd, SET_PRECHARGE);                   // Configura o tempo de pré-carga
-  ssd1306_command(ssd, ssd->external_vcc ? 0x22 : 0xF1); // Configuração de pré-carga
-  ssd1306_command(ssd, SET_VCOM_DESEL);                  // Configura o nível VCOMH
-  ssd1306_command(ssd, 0x30);                            // Configuração padrão
-  ssd1306_command(ssd, SET_CONTRAST);                    // Configura o contraste
-  ssd1306_command(ssd, 0xFF);                            // Contraste máximo
-  ssd1306_command(ssd, SET_ENTIRE_ON);                   // Habilita o display inteiro
-  ssd1306_command(ssd, SET_NORM_INV);                    // Display normal (não invertido)
-  ssd1306_command(ssd, SET_CHARGE_PUMP);                 // Configura a bomba de carga
-  ssd1306_command(ssd, ssd->external_vcc ? 0x10 : 0x14); // Habilita a bomba de carga
-  ssd1306_command(ssd, SET_DISP | 0x01);                 // Liga o display
+  uint8_t com_pins = SSD_HEIGHT(ssd) == 32 ? 0x02 : 0x12;
+  ssd1306_cmdlist_t list;
+  ssd1306_cmdlist_begin(&list);
+  ssd1306_cmdlist_add(&list, SET_DISP | 0x00);                 // Desliga o display
+  ssd1306_cmdlist_add(&list, SET_MEM_ADDR);                    // Configura o modo de endereçamento de memória
+  ssd1306_cmdlist_add(&list, 0x00);                            // Modo horizontal
+  ssd1306_cmdlist_add(&list, SET_DISP_START_LINE | ssd->start_line); // Define a linha inicial do display
+  ssd1306_cmdlist_add(&list, SET_SEG_REMAP | 0x01);            // Mapeamento de segmentos (inverte colunas)
+  ssd1306_cmdlist_add(&list, SET_MUX_RATIO);                   // Configura a proporção do multiplexador
+  ssd1306_cmdlist_add(&list, SSD_HEIGHT(ssd) - 1);             // Altura do display - 1
+  ssd1306_cmdlist_add(&list, SET_COM_OUT_DIR | 0x08);          // Define a direção dos pinos COM
+  ssd1306_cmdlist_add(&list, SET_DISP_OFFSET);                 // Define o deslocamento do display
+  ssd1306_cmdlist_add(&list, 0x00);                            // Sem deslocamento
+  ssd1306_cmdlist_add(&list, SET_COM_PIN_CFG);                 // Configura os pinos COM
+  ssd1306_cmdlist_add(&list, com_pins);                        // Sequencial no 128x32, alternada nos demais
+  ssd1306_cmdlist_add(&list, SET_DISP_CLK_DIV);                // Configura o divisor de clock
+  ssd1306_cmdlist_add(&list, 0x80);                            // Frequência padrão
+  ssd1306_cmdlist_add(&list, SET_PRECHARGE);                   // Configura o tempo de pré-carga
+  ssd1306_cmdlist_add(&list, ssd->external_vcc ? 0x22 : 0xF1); // Configuração de pré-carga
+  ssd1306_cmdlist_add(&list, SET_VCOM_DESEL);                  // Configura o nível VCOMH
+  ssd1306_cmdlist_add(&list, 0x30);                            // Configuração padrão
+  ssd1306_cmdlist_add(&list, SET_CONTRAST);                    // Configura o contraste
+  ssd1306_cmdlist_add(&list, 0xFF);                            // Contraste máximo
+  ssd1306_cmdlist_add(&list, SET_ENTIRE_ON);                   // Habilita o display inteiro
+  ssd1306_cmdlist_add(&list, SET_NORM_INV);                    // Display normal (não invertido)
+  ssd1306_cmdlist_add(&list, SET_CHARGE_PUMP);                 // Configura a bomba de carga
+  ssd1306_cmdlist_add(&list, ssd->external_vcc ? 0x10 : 0x14); // Habilita a bomba de carga
+  ssd1306_cmdlist_add(&list, SET_DISP | 0x01);                 // Liga o display
+  ssd1306_cmdlist_send(ssd, &list);
+}
+
+// Ajusta o contraste (brilho) do display
+void ssd1306_set_contrast(ssd1306_t *ssd, uint8_t contrast)
+{
+  ssd1306_cmdlist_t list;
+  ssd1306_cmdlist_begin(&list);
+  ssd1306_cmdlist_add(&list, SET_CONTRAST);
+  ssd1306_cmdlist_add(&list, contrast);
+  ssd1306_cmdlist_send(ssd, &list);
+}
+
+// Inverte (ou não) as cores do display
+void ssd1306_invert(ssd1306_t *ssd, bool invert)
+{
+  ssd1306_command(ssd, SET_NORM_INV | (invert ? 0x01 : 0x00));
+}
+
+// Liga ou desliga o painel (a GDDRAM é preservada)
+void ssd1306_display_on(ssd1306_t *ssd, bool on)
+{
+  ssd1306_command(ssd, SET_DISP | (on ? 0x01 : 0x00));
 }
 
 // Desenha um pixel na posição (x, y)
 void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value)
 {
-  if (x >= ssd->width || y >= ssd->height)
+  if (x >= SSD_WIDTH(ssd) || y >= SSD_HEIGHT(ssd))
     return; // Verifica limites
-  uint16_t index = 1 + (y / 8) * ssd->width + x;
+  uint16_t index = 1 + (y / 8) * SSD_WIDTH(ssd) + x;
   uint8_t bit = y % 8;
   if (value)
     ssd->ram_buffer[index] |= (1 << bit);
   else
     ssd->ram_buffer[index] &= ~(1 << bit);
+  ssd1306_mark_dirty(ssd, x, x, y / 8, y / 8);
 }
 
-// Preenche o display com um valor (true = ligado, false = desligado)
-void ssd1306_fill(ssd1306_t *ssd, bool value)
+// Máscara dos bits da página 'page' que ficam entre as linhas y0 e y1 (inclusive)
+static inline uint8_t ssd1306_page_mask(uint8_t page, uint16_t y0, uint16_t y1)
 {
-  uint8_t byte = value ? 0xFF : 0x00;
-  for (uint16_t i = 1; i < ssd->bufsize; i++)
+  uint16_t top = page * 8U;
+  uint8_t mask = 0xFF;
+  if (y0 > top)
+    mask &= (uint8_t)(0xFF << (y0 - top));
+  if (y1 < top + 7)
+    mask &= (uint8_t)(0xFF >> (top + 7 - y1));
+  return mask;
+}
+
+// Liga ou desliga a área x0..x1 / y0..y1 (inclusive) operando um byte (8 linhas) por vez
+static void ssd1306_fill_area(ssd1306_t *ssd, uint16_t x0, uint16_t x1, uint16_t y0, uint16_t y1, bool value)
+{
+  if (x0 >= SSD_WIDTH(ssd) || y0 >= SSD_HEIGHT(ssd) || x1 < x0 || y1 < y0)
+    return;
+  if (x1 >= SSD_WIDTH(ssd))
+    x1 = SSD_WIDTH(ssd) - 1;
+  if (y1 >= SSD_HEIGHT(ssd))
+    y1 = SSD_HEIGHT(ssd) - 1;
+
+  uint8_t page0 = y0 / 8, page1 = y1 / 8;
+  for (uint8_t page = page0; page <= page1; page++)
   {
-    ssd->ram_buffer[i] = byte;
+    uint8_t mask = ssd1306_page_mask(page, y0, y1);
+    uint8_t *col = &ssd->ram_buffer[1 + page * SSD_WIDTH(ssd) + x0];
+    uint8_t *end = col + (x1 - x0) + 1;
+    if (value)
+      for (; col < end; col++)
+        *col |= mask;
+    else
+      for (; col < end; col++)
+        *col &= ~mask;
   }
+  ssd1306_mark_dirty(ssd, x0, x1, page0, page1);
+}
+
+// Copia os 8 bits de 'bits' para a coluna x a partir da linha y (pode ocupar duas páginas).
+// Só os bits presentes em 'mask' são alterados. Não marca a região como suja.
+static inline void ssd1306_blit_column(ssd1306_t *ssd, uint8_t x, uint8_t y, uint8_t bits, uint8_t mask)
+{
+  uint8_t page = y / 8, shift = y % 8;
+  uint8_t *col = &ssd->ram_buffer[1 + page * SSD_WIDTH(ssd) + x];
+  uint16_t m = (uint16_t)mask << shift;
+  uint16_t b = (uint16_t)(bits & mask) << shift;
+
+  col[0] = (col[0] & ~m) | b;
+  if (shift && page + 1 < SSD_PAGES(ssd))
+    col[SSD_WIDTH(ssd)] = (col[SSD_WIDTH(ssd)] & ~(m >> 8)) | (b >> 8);
+}
+
+// Preenche o display com um valor (true = ligado, false = desligado)
+void ssd1306_fill(ssd1306_t *ssd, bool value)
+{
+  memset(&ssd->ram_buffer[1], value ? 0xFF : 0x00, SSD_BUFSIZE(ssd) - 1);
+  ssd1306_mark_dirty(ssd, 0, SSD_WIDTH(ssd) - 1, 0, SSD_PAGES(ssd) - 1);
+}
+
+// Desenha uma linha horizontal de w pixels a partir de (x, y)
+void ssd1306_hline(ssd1306_t *ssd, uint8_t x, uint8_t y, uint8_t w, bool value)
+{
+  if (w)
+    ssd1306_fill_area(ssd, x, x + w - 1, y, y, value);
+}
+
+// Desenha uma linha vertical de h pixels a partir de (x, y)
+void ssd1306_vline(ssd1306_t *ssd, uint8_t x, uint8_t y, uint8_t h, bool value)
+{
+  if (h)
+    ssd1306_fill_area(ssd, x, x, y, y + h - 1, value);
 }
 
 // Desenha um retângulo
 void ssd1306_rect(ssd1306_t *ssd, uint8_t x, uint8_t y, uint8_t w, uint8_t h, bool value, bool fill)
 {
-  for (uint8_t i = x; i < x + w; i++)
+  if (!w || !h)
+    return;
+  if (fill)
   {
-    for (uint8_t j = y; j < y + h; j++)
-    {
-      if (fill || i == x || i == x + w - 1 || j == y || j == y + h - 1)
-      {
-        ssd1306_pixel(ssd, i, j, value);
-      }
-    }
+    ssd1306_fill_area(ssd, x, x + w - 1, y, y + h - 1, value);
+    return;
   }
+  ssd1306_hline(ssd, x, y, w, value);
+  ssd1306_hline(ssd, x, y + h - 1, w, value);
+  ssd1306_vline(ssd, x, y, h, value);
+  ssd1306_vline(ssd, x + w - 1, y, h, value);
 }
 
 // Desenha uma linha
 void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, bool value)
 {
+  // Linhas horizontais e verticais usam o preenchimento por bytes
+  if (y0 == y1)
+  {
+    ssd1306_fill_area(ssd, x0 < x1 ? x0 : x1, x0 < x1 ? x1 : x0, y0, y0, value);
+    return;
+  }
+  if (x0 == x1)
+  {
+    ssd1306_fill_area(ssd, x0, x0, y0 < y1 ? y0 : y1, y0 < y1 ? y1 : y0, value);
+    return;
+  }
+
   int dx = abs(x1 - x0);
   int dy = abs(y1 - y0);
   int sx = (x0 < x1) ? 1 : -1;
@@ -132,52 +600,348 @@ void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1
   }
 }
 
+// Posição do glifo de um caractere na fonte; fora do ASCII imprimível usa '?'
+static inline uint8_t ssd1306_glyph_index(char c)
+{
+  uint8_t code = (uint8_t)c;
+  if (code < FONT_FIRST || code > FONT_LAST)
+    code = '?';
+  return code - FONT_FIRST;
+}
+
 // Desenha um caractere na posição (x, y)
 void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y)
 {
-  uint16_t index = 0;
-  if (c >= 'A' && c <= 'Z')
+  if (x >= SSD_WIDTH(ssd) || y >= SSD_HEIGHT(ssd))
+    return; // Verifica limites
+  uint8_t last_x = (x + 7 < SSD_WIDTH(ssd)) ? x + 7 : SSD_WIDTH(ssd) - 1;
+  uint8_t last_y = (y + 7 < SSD_HEIGHT(ssd)) ? y + 7 : SSD_HEIGHT(ssd) - 1;
+
+  // Cada byte da fonte é uma coluna do caractere: copia coluna a coluna
+  const uint8_t *glyph = &font[ssd1306_glyph_index(c) * FONT_WIDTH];
+  for (uint8_t col = x; col <= last_x; col++)
+  {
+    ssd1306_blit_column(ssd, col, y, *glyph++, 0xFF);
+  }
+  ssd1306_mark_dirty(ssd, x, last_x, y / 8, last_y / 8);
+}
+
+// Desenha uma string na posição (x, y), 8 pixels por caractere, quebrando a linha no fim da tela
+void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y)
+{
+  while (*str)
+  {
+    ssd1306_draw_char(ssd, *str++, x, y);
+    x += 8;
+    if (x + 8 > SSD_WIDTH(ssd))
+    {
+      x = 0;
+      y += 8;
+    }
+    if (y + 8 > SSD_HEIGHT(ssd))
+    {
+      break;
+    }
+  }
+}
+
+// Largura em pixels de uma string na fonte proporcional
+uint16_t ssd1306_string_width(const char *str)
+{
+  uint16_t width = 0;
+  for (; *str; str++)
+    width += font_widths[ssd1306_glyph_index(*str)] + 1;
+  return width ? width - 1 : 0; // Sem a coluna vazia depois do último glifo
+}
+
+// Renderiza uma string proporcional como uma faixa de colunas de 8 pixels.
+// Retorna quantas colunas foram usadas (no máximo 'max').
+static uint8_t ssd1306_render_strip(const char *str, uint8_t *cols, uint8_t max)
+{
+  uint8_t len = 0;
+  for (; *str && len < max; str++)
   {
-    index = (c - 'A' + 11) * 8; // Letras maiúsculas (A-Z).
+    uint8_t glyph = ssd1306_glyph_index(*str);
+    const uint8_t *col = &font[glyph * FONT_WIDTH + font_first_col[glyph]];
+    for (uint8_t i = 0; i < font_widths[glyph] && len < max; i++)
+      cols[len++] = *col++;
+    if (str[1] && len < max)
+      cols[len++] = 0x00; // Coluna vazia entre os glifos
   }
-  else if (c >= 'a' && c <= 'z')
+  return len;
+}
+
+// Copia uma faixa de colunas para a posição (x, y), cortada na borda da tela. Com y
+// múltiplo de 8 a faixa cai inteira numa página e a cópia é um único memcpy.
+static void ssd1306_blit_strip(ssd1306_t *ssd, const uint8_t *cols, uint8_t len, uint8_t x, uint8_t y)
+{
+  if (x >= SSD_WIDTH(ssd) || y >= SSD_HEIGHT(ssd) || len == 0)
+    return;
+  if (len > SSD_WIDTH(ssd) - x)
+    len = SSD_WIDTH(ssd) - x;
+
+  if (y % 8 == 0)
+    memcpy(&ssd->ram_buffer[1 + (y / 8) * SSD_WIDTH(ssd) + x], cols, len);
+  else
+    for (uint8_t i = 0; i < len; i++)
+      ssd1306_blit_column(ssd, x + i, y, cols[i], 0xFF);
+
+  uint8_t last_y = (y + 7 < SSD_HEIGHT(ssd)) ? y + 7 : SSD_HEIGHT(ssd) - 1;
+  ssd1306_mark_dirty(ssd, x, x + len - 1, y / 8, last_y / 8);
+}
+
+// Desenha uma string proporcional numa linha a partir de (x, y), cortada na borda da tela.
+// Retorna a coluna logo após o texto.
+uint8_t ssd1306_draw_string_prop(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y)
+{
+  if (x >= SSD_WIDTH(ssd))
+    return x;
+  uint8_t cols[WIDTH];
+  uint8_t max = (SSD_WIDTH(ssd) - x < WIDTH) ? SSD_WIDTH(ssd) - x : WIDTH;
+  uint8_t len = ssd1306_render_strip(str, cols, max);
+  ssd1306_blit_strip(ssd, cols, len, x, y);
+  return x + len;
+}
+
+// Cache de faixas já renderizadas: as mensagens se repetem, então cada uma é montada
+// glifo a glifo só na primeira vez. Um texto novo ocupa a entrada usada há mais tempo.
+typedef struct
+{
+  char text[SSD1306_TEXT_CACHE_CHARS + 1];
+  uint32_t hash;      // FNV-1a do texto, para descartar comparações
+  uint32_t last_use;  // 0 = entrada vazia
+  uint8_t len;
+  uint8_t cols[WIDTH];
+} ssd1306_text_cache_entry_t;
+
+static ssd1306_text_cache_entry_t text_cache[SSD1306_TEXT_CACHE_ENTRIES];
+static uint32_t text_cache_clock = 0;
+ssd1306_text_cache_stats_t ssd1306_text_cache_stats;
+
+static uint32_t ssd1306_text_hash(const char *str, size_t *len)
+{
+  const char *start = str;
+  uint32_t hash = 2166136261u;
+  for (; *str; str++)
+    hash = (hash ^ (uint8_t)*str) * 16777619u;
+  *len = str - start;
+  return hash;
+}
+
+// Como ssd1306_draw_string_prop, mas reaproveita a faixa renderizada nos próximos desenhos.
+// O cache é compartilhado: use de um núcleo só.
+uint8_t ssd1306_draw_string_cached(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y)
+{
+  size_t chars;
+  uint32_t hash = ssd1306_text_hash(str, &chars);
+  if (chars > SSD1306_TEXT_CACHE_CHARS)
+    return ssd1306_draw_string_prop(ssd, str, x, y); // Longo demais para o cache
+
+  ssd1306_text_cache_entry_t *entry = NULL, *oldest = &text_cache[0];
+  for (size_t i = 0; i < SSD1306_TEXT_CACHE_ENTRIES; i++)
   {
-    index = (c - 'a' + 37) * 8; // Letras minúsculas (a-z)
+    ssd1306_text_cache_entry_t *e = &text_cache[i];
+    if (e->last_use && e->hash == hash && strcmp(e->text, str) == 0)
+    {
+      entry = e;
+      break;
+    }
+    if (e->last_use < oldest->last_use)
+      oldest = e;
   }
-  else if (c >= '0' && c <= '9')
+
+  if (entry)
   {
-    index = (c - '0' + 1) * 8; // Números (0-9)
+    ssd1306_text_cache_stats.hits++;
   }
   else
   {
-    return; // Caractere não suportado
+    ssd1306_text_cache_stats.misses++;
+    entry = oldest;
+    memcpy(entry->text, str, chars + 1);
+    entry->hash = hash;
+    entry->len = ssd1306_render_strip(str, entry->cols, WIDTH);
   }
+  entry->last_use = ++text_cache_clock;
 
-  for (uint8_t i = 0; i < 8; i++)
+  if (x >= SSD_WIDTH(ssd))
+    return x;
+  ssd1306_blit_strip(ssd, entry->cols, entry->len, x, y);
+  return (entry->len < SSD_WIDTH(ssd) - x) ? x + entry->len : SSD_WIDTH(ssd);
+}
+
+// Desenha uma imagem comprimida (gerada por ferramentas/gerar_imagens.py) com o canto
+// superior esquerdo em (x, y), cortada na borda da tela. Os blocos RLE são lidos direto de
+// image->data (na flash, via XIP) e gravados no ram_buffer sem cópia intermediária. Com y
+// múltiplo de 8 e a imagem inteira na tela, cada bloco vira um memset ou um memcpy.
+void ssd1306_draw_image(ssd1306_t *ssd, const ssd1306_image_t *image, uint8_t x, uint8_t y)
+{
+  if (x >= SSD_WIDTH(ssd) || y >= SSD_HEIGHT(ssd) || !image->width || !image->height)
+    return;
+
+  uint8_t pages = (image->height + 7) / 8;
+  uint8_t last_mask = (image->height % 8) ? (1u << (image->height % 8)) - 1 : 0xFF; // Última página incompleta
+  bool direct = y % 8 == 0 && last_mask == 0xFF && x + image->width <= SSD_WIDTH(ssd) &&
+                y + image->height <= SSD_HEIGHT(ssd);
+  const uint8_t *src = image->data, *end = image->data + image->size;
+  uint8_t col = 0, page = 0;
+
+  while (src < end && page < pages)
   {
-    uint8_t line = font[index + i];
-    for (uint8_t j = 0; j < 8; j++)
+    uint8_t control = *src++;
+    bool repeat = control & 0x80;
+    uint16_t count = repeat ? (control & 0x7F) + 2 : control + 1;
+    const uint8_t *bytes = src;
+    src += repeat ? 1 : count;
+
+    // Um bloco pode atravessar o fim de uma página da imagem: vai em trechos até a borda
+    while (count && page < pages)
     {
-      ssd1306_pixel(ssd, x + i, y + j, line & (1 << j));
+      uint16_t n = (image->width - col < count) ? image->width - col : count;
+      if (direct)
+      {
+        uint8_t *dst = &ssd->ram_buffer[1 + (y / 8 + page) * SSD_WIDTH(ssd) + x + col];
+        if (repeat)
+          memset(dst, *bytes, n);
+        else
+          memcpy(dst, bytes, n);
+      }
+      else
+      {
+        uint8_t mask = (page == pages - 1) ? last_mask : 0xFF;
+        uint16_t py = y + page * 8;
+        for (uint16_t i = 0; i < n && py < SSD_HEIGHT(ssd); i++)
+        {
+          uint16_t px = x + col + i;
+          if (px < SSD_WIDTH(ssd))
+            ssd1306_blit_column(ssd, px, py, repeat ? *bytes : bytes[i], mask);
+        }
+      }
+
+      if (!repeat)
+        bytes += n;
+      count -= n;
+      col += n;
+      if (col == image->width)
+      {
+        col = 0;
+        page++;
+      }
     }
   }
+
+  uint8_t last_x = (x + image->width - 1 < SSD_WIDTH(ssd)) ? x + image->width - 1 : SSD_WIDTH(ssd) - 1;
+  uint8_t last_y = (y + image->height - 1 < SSD_HEIGHT(ssd)) ? y + image->height - 1 : SSD_HEIGHT(ssd) - 1;
+  ssd1306_mark_dirty(ssd, x, last_x, y / 8, last_y / 8);
 }
 
-// Desenha uma string na posição (x, y)
-void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y)
+// Byte (bits ou máscara) da página 'page' do sprite na coluna 'col'; 0 fora do sprite
+static inline uint8_t ssd1306_sprite_byte(const ssd1306_sprite_t *sprite, bool mask, int16_t page, uint8_t col)
 {
-  while (*str)
+  uint8_t pages = (sprite->height + 7) / 8;
+  if (page < 0 || page >= pages)
+    return 0;
+  uint8_t m = 0xFF;
+  if (page == pages - 1 && sprite->height % 8)
+    m = (1u << (sprite->height % 8)) - 1;
+  if (sprite->mask)
+    m &= sprite->mask[page * sprite->width + col];
+  return mask ? m : sprite->bits[page * sprite->width + col] & m;
+}
+
+// Desenha um sprite com o canto superior esquerdo em (x, y), cortado na borda da tela,
+// deslocando os bits na hora. Para sprites desenhados a todo quadro, use um
+// ssd1306_sprite_cache_t.
+void ssd1306_draw_sprite(ssd1306_t *ssd, const ssd1306_sprite_t *sprite, uint8_t x, uint8_t y)
+{
+  if (x >= SSD_WIDTH(ssd) || y >= SSD_HEIGHT(ssd) || !sprite->width || !sprite->height)
+    return;
+
+  uint8_t pages = (sprite->height + 7) / 8;
+  for (uint8_t page = 0; page < pages && y + page * 8 < SSD_HEIGHT(ssd); page++)
   {
-    ssd1306_draw_char(ssd, *str++, x, y);
-    x += 8;
-    if (x + 8 >= ssd->width)
+    for (uint8_t col = 0; col < sprite->width && x + col < SSD_WIDTH(ssd); col++)
     {
-      x = 0;
-      y += 8;
+      ssd1306_blit_column(ssd, x + col, y + page * 8, ssd1306_sprite_byte(sprite, false, page, col),
+                          ssd1306_sprite_byte(sprite, true, page, col));
     }
-    if (y + 8 >= ssd->height)
+  }
+
+  uint8_t last_x = (x + sprite->width - 1 < SSD_WIDTH(ssd)) ? x + sprite->width - 1 : SSD_WIDTH(ssd) - 1;
+  uint8_t last_y = (y + sprite->height - 1 < SSD_HEIGHT(ssd)) ? y + sprite->height - 1 : SSD_HEIGHT(ssd) - 1;
+  ssd1306_mark_dirty(ssd, x, last_x, y / 8, last_y / 8);
+}
+
+// Prepara as 8 variantes deslocadas do sprite em 'buffer', que precisa de
+// SSD1306_SPRITE_CACHE_SIZE(largura, altura) bytes e deve durar tanto quanto o cache.
+// Retorna false se o buffer for pequeno. Se o sprite mudar, chame de novo.
+bool ssd1306_sprite_cache_init(ssd1306_sprite_cache_t *cache, const ssd1306_sprite_t *sprite, uint8_t *buffer, size_t size)
+{
+  if (!sprite->width || !sprite->height || size < SSD1306_SPRITE_CACHE_SIZE((size_t)sprite->width, sprite->height))
+    return false;
+
+  cache->sprite = sprite;
+  cache->pages = (sprite->height + 7) / 8 + 1;
+  cache->data = buffer;
+
+  uint8_t *dst = buffer;
+  for (uint8_t shift = 0; shift < 8; shift++)
+  {
+    for (uint8_t plane = 0; plane < 2; plane++)
     {
-      break;
+      for (uint8_t page = 0; page < cache->pages; page++)
+      {
+        for (uint8_t col = 0; col < sprite->width; col++)
+        {
+          // Os bits de baixo da página de cima escorrem para o alto desta
+          uint8_t atual = ssd1306_sprite_byte(sprite, plane, page, col);
+          uint8_t acima = ssd1306_sprite_byte(sprite, plane, page - 1, col);
+          *dst++ = shift ? (uint8_t)((atual << shift) | (acima >> (8 - shift))) : atual;
+        }
+      }
     }
   }
-}
\ No newline at end of file
+  return true;
+}
+
+// Aplica a variante do cache para a linha y: desenha o sprite ou, com 'erase', apaga os
+// pixels cobertos pela máscara
+static void ssd1306_blit_sprite_cached(ssd1306_t *ssd, const ssd1306_sprite_cache_t *cache, uint8_t x, uint8_t y, bool erase)
+{
+  const ssd1306_sprite_t *sprite = cache->sprite;
+  if (x >= SSD_WIDTH(ssd) || y >= SSD_HEIGHT(ssd))
+    return;
+
+  uint8_t width = (x + sprite->width <= SSD_WIDTH(ssd)) ? sprite->width : SSD_WIDTH(ssd) - x;
+  uint8_t last_y = (y + sprite->height - 1 < SSD_HEIGHT(ssd)) ? y + sprite->height - 1 : SSD_HEIGHT(ssd) - 1;
+  uint8_t page0 = y / 8, page1 = last_y / 8;
+  size_t plane = (size_t)cache->pages * sprite->width;
+  const uint8_t *bits = cache->data + (y % 8) * 2 * plane;
+  const uint8_t *mask = bits + plane;
+
+  for (uint8_t page = page0; page <= page1; page++)
+  {
+    uint8_t *col = &ssd->ram_buffer[1 + page * SSD_WIDTH(ssd) + x];
+    const uint8_t *b = bits + (page - page0) * sprite->width;
+    const uint8_t *m = mask + (page - page0) * sprite->width;
+    if (erase)
+      for (uint8_t i = 0; i < width; i++)
+        col[i] &= ~m[i];
+    else
+      for (uint8_t i = 0; i < width; i++)
+        col[i] = (col[i] & ~m[i]) | b[i];
+  }
+  ssd1306_mark_dirty(ssd, x, x + width - 1, page0, page1);
+}
+
+// Desenha o sprite do cache em (x, y), cortado na borda da tela
+void ssd1306_draw_sprite_cached(ssd1306_t *ssd, const ssd1306_sprite_cache_t *cache, uint8_t x, uint8_t y)
+{
+  ssd1306_blit_sprite_cached(ssd, cache, x, y, false);
+}
+
+// Apaga os pixels que o sprite do cache cobre em (x, y), por exemplo para movê-lo
+void ssd1306_erase_sprite_cached(ssd1306_t *ssd, const ssd1306_sprite_cache_t *cache, uint8_t x, uint8_t y)
+{
+  ssd1306_blit_sprite_cached(ssd, cache, x, y, true);
+}
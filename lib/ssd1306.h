@@ -4,10 +4,42 @@
 #include <stdlib.h>
 #include "pico/stdlib.h"
 #include "hardware/i2c.h"
+#include "hardware/dma.h"
 
 #define WIDTH 128
 #define HEIGHT 64
 
+#define SSD1306_MAX_PAGES 8       // Maior número de páginas suportado (64 linhas)
+#define SSD1306_WINDOW_OVERHEAD 10 // Bytes gastos para abrir uma janela de envio
+#define SSD1306_START_LINE_OVERHEAD 2 // Transação que muda a linha inicial, no fim do fluxo
+#define SSD1306_CMDLIST_MAX 32    // Máximo de comandos numa transação
+#define SSD1306_TEXT_CACHE_ENTRIES 4 // Textos guardados já renderizados
+#define SSD1306_TEXT_CACHE_CHARS 24  // Maior texto aceito pelo cache
+#define SSD1306_SCHEDULER_MAX 4      // Painéis por agendador
+
+// Bytes de RAM para as 8 variantes deslocadas de um sprite w x h (bits e máscara, com uma
+// página a mais para o que escorre para baixo)
+#define SSD1306_SPRITE_CACHE_SIZE(w, h) (16 * (w) * (((h) + 7) / 8 + 1))
+
+// Geometria fixa: com SSD1306_FIXED_GEOMETRY definido, o painel tem sempre
+// SSD1306_FIXED_WIDTH x SSD1306_FIXED_HEIGHT pixels (padrão WIDTH x HEIGHT), os buffers
+// ficam dentro do ssd1306_t, sem heap, e as contas de índice usam constantes. Sem ele, a
+// geometria vem de ssd1306_init e os buffers são alocados em tempo de execução.
+#ifdef SSD1306_FIXED_GEOMETRY
+#ifndef SSD1306_FIXED_WIDTH
+#define SSD1306_FIXED_WIDTH WIDTH
+#endif
+#ifndef SSD1306_FIXED_HEIGHT
+#define SSD1306_FIXED_HEIGHT HEIGHT
+#endif
+#if !((SSD1306_FIXED_WIDTH == 128 && SSD1306_FIXED_HEIGHT == 64) || \
+      (SSD1306_FIXED_WIDTH == 128 && SSD1306_FIXED_HEIGHT == 32) || \
+      (SSD1306_FIXED_WIDTH == 64 && SSD1306_FIXED_HEIGHT == 48))
+#error "Geometria do SSD1306 não suportada (use 128x64, 128x32 ou 64x48)"
+#endif
+#define SSD1306_FIXED_BUFSIZE (SSD1306_FIXED_WIDTH * SSD1306_FIXED_HEIGHT / 8 + 1)
+#endif
+
 typedef enum
 {
   SET_CONTRAST = 0x81,
@@ -34,20 +66,126 @@ typedef struct
   uint8_t width, height, pages, address;
   i2c_inst_t *i2c_port;
   bool external_vcc;
+#ifdef SSD1306_FIXED_GEOMETRY
+  uint8_t ram_buffer[SSD1306_FIXED_BUFSIZE];
+#else
   uint8_t *ram_buffer;
+#endif
   size_t bufsize;
   uint8_t port_buffer[2];
+#ifdef SSD1306_FIXED_GEOMETRY
+  uint8_t shadow_buffer[SSD1306_FIXED_BUFSIZE - 1];
+#else
+  uint8_t *shadow_buffer;                // Cópia do que já está na GDDRAM do display
+#endif
+  bool shadow_valid;                     // Falso até o primeiro envio completo
+  uint8_t dirty_x0[SSD1306_MAX_PAGES];   // Primeira coluna alterada de cada página
+  uint8_t dirty_x1[SSD1306_MAX_PAGES];   // Última coluna alterada (x0 > x1 = página limpa)
+#ifdef SSD1306_FIXED_GEOMETRY
+  uint16_t tx_stream[SSD1306_FIXED_BUFSIZE + SSD1306_WINDOW_OVERHEAD + SSD1306_START_LINE_OVERHEAD];
+#else
+  uint16_t *tx_stream;                   // Quadro em transmissão, já no formato do registrador IC_DATA_CMD
+#endif
+  size_t tx_capacity, tx_len;
+  uint16_t tx_transactions;              // Transações (cada uma termina num STOP) no fluxo
+  uint8_t start_line;                    // Linha da GDDRAM exibida no alto da tela
+  bool start_line_dirty;                 // start_line ainda não foi enviada
+  int dma_channel;
+  bool flushing;                         // Há uma transferência por DMA em andamento
+  uint32_t bytes_sent;                   // Total de bytes enviados pelo I2C
+  uint32_t frames_sent;                  // Envios iniciados por ssd1306_flush_start
+  uint32_t tx_errors;                    // Transferências abortadas (NACK)
 } ssd1306_t;
 
+// Acertos e falhas do cache de textos (compartilhado por todos os displays)
+typedef struct
+{
+  uint32_t hits;
+  uint32_t misses;
+} ssd1306_text_cache_stats_t;
+
+extern ssd1306_text_cache_stats_t ssd1306_text_cache_stats;
+
+// Imagem comprimida gerada por ferramentas/gerar_imagens.py: colunas de 8 pixels página a
+// página, em RLE. Fica como const na flash e é desenhada direto de lá.
+typedef struct
+{
+  uint8_t width, height;
+  uint16_t size;      // Bytes em data
+  const uint8_t *data;
+} ssd1306_image_t;
+
+// Sprite: bitmap no formato do framebuffer (colunas de 8 pixels, bit 0 no alto, página a
+// página) com uma máscara de transparência no mesmo formato; só os pixels com 1 na máscara
+// são alterados. Sem máscara (NULL), o retângulo width x height inteiro é opaco.
+typedef struct
+{
+  uint8_t width, height;
+  const uint8_t *bits; // width * páginas bytes
+  const uint8_t *mask; // Idem, ou NULL
+} ssd1306_sprite_t;
+
+// Variantes de um sprite já deslocadas de 0 a 7 linhas para baixo. Com elas, desenhar em
+// qualquer y é só um E e um OU por byte do framebuffer, sem deslocar bits na hora.
+typedef struct
+{
+  const ssd1306_sprite_t *sprite;
+  uint8_t pages; // Páginas de cada variante (as do sprite mais uma)
+  uint8_t *data; // Variante s: bits e depois máscara, cada um com pages * width bytes
+} ssd1306_sprite_cache_t;
+
+// Agendador de envios para vários painéis, em i2c0 e i2c1 e em endereços diferentes no
+// mesmo barramento. Cada painel tem seu buffer e seu canal de DMA; o agendador só decide
+// quem transmite, um painel por barramento de cada vez, sem nunca esperar.
+typedef struct
+{
+  ssd1306_t *panels[SSD1306_SCHEDULER_MAX];
+  uint8_t count;
+  uint8_t next;      // Painel que tem a primeira chance no próximo ssd1306_scheduler_poll
+  uint32_t flushing; // Bit i: panels[i] transmite
+} ssd1306_scheduler_t;
+
+typedef struct
+{
+  uint8_t buf[SSD1306_CMDLIST_MAX + 1]; // Byte de controle seguido dos comandos
+  uint8_t len;
+} ssd1306_cmdlist_t;
+
 void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c);
 void ssd1306_config(ssd1306_t *ssd);
 void ssd1306_command(ssd1306_t *ssd, uint8_t command);
+void ssd1306_cmdlist_begin(ssd1306_cmdlist_t *list);
+void ssd1306_cmdlist_add(ssd1306_cmdlist_t *list, uint8_t command);
+void ssd1306_cmdlist_send(ssd1306_t *ssd, const ssd1306_cmdlist_t *list);
+void ssd1306_set_contrast(ssd1306_t *ssd, uint8_t contrast);
+void ssd1306_invert(ssd1306_t *ssd, bool invert);
+void ssd1306_display_on(ssd1306_t *ssd, bool on);
 void ssd1306_send_data(ssd1306_t *ssd);
+bool ssd1306_flush_start(ssd1306_t *ssd);
+uint32_t ssd1306_flush_bits(const ssd1306_t *ssd);
+bool ssd1306_flush_busy(ssd1306_t *ssd);
+void ssd1306_flush_wait(ssd1306_t *ssd);
+void ssd1306_invalidate(ssd1306_t *ssd);
+bool ssd1306_has_changes(const ssd1306_t *ssd);
+void ssd1306_set_start_line(ssd1306_t *ssd, uint8_t line);
+void ssd1306_scheduler_init(ssd1306_scheduler_t *sched);
+bool ssd1306_scheduler_add(ssd1306_scheduler_t *sched, ssd1306_t *ssd);
+uint32_t ssd1306_scheduler_poll(ssd1306_scheduler_t *sched, uint32_t *started);
 void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value);
 void ssd1306_fill(ssd1306_t *ssd, bool value);
+void ssd1306_hline(ssd1306_t *ssd, uint8_t x, uint8_t y, uint8_t w, bool value);
+void ssd1306_vline(ssd1306_t *ssd, uint8_t x, uint8_t y, uint8_t h, bool value);
 void ssd1306_rect(ssd1306_t *ssd, uint8_t x, uint8_t y, uint8_t w, uint8_t h, bool value, bool fill);
 void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, bool value);
 void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y);
 void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y);
+uint16_t ssd1306_string_width(const char *str);
+uint8_t ssd1306_draw_string_prop(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y);
+uint8_t ssd1306_draw_string_cached(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y);
+void ssd1306_draw_image(ssd1306_t *ssd, const ssd1306_image_t *image, uint8_t x, uint8_t y);
+void ssd1306_draw_sprite(ssd1306_t *ssd, const ssd1306_sprite_t *sprite, uint8_t x, uint8_t y);
+bool ssd1306_sprite_cache_init(ssd1306_sprite_cache_t *cache, const ssd1306_sprite_t *sprite, uint8_t *buffer, size_t size);
+void ssd1306_draw_sprite_cached(ssd1306_t *ssd, const ssd1306_sprite_cache_t *cache, uint8_t x, uint8_t y);
+void ssd1306_erase_sprite_cached(ssd1306_t *ssd, const ssd1306_sprite_cache_t *cache, uint8_t x, uint8_t y);
 
 #endif // SSD1306_H
\ No newline at end of file
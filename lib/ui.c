@@ -0,0 +1,260 @@
+#include "ui.h"
+#include <string.h>
+
+// Prepara um rótulo vazio na área (x, y, largura, altura)
+void ui_rotulo_init(ui_rotulo_t *rotulo, uint8_t x, uint8_t y, uint8_t largura, uint8_t altura)
+{
+  rotulo->x = x;
+  rotulo->y = y;
+  rotulo->largura = largura;
+  rotulo->altura = altura;
+  rotulo->texto[0] = '\0';
+  rotulo->sujo = true;
+}
+
+// Troca o texto; o mesmo texto não causa redesenho
+void ui_rotulo_definir(ui_rotulo_t *rotulo, const char *texto)
+{
+  if (strncmp(rotulo->texto, texto, UI_TEXTO_MAX) == 0)
+    return;
+  strncpy(rotulo->texto, texto, UI_TEXTO_MAX);
+  rotulo->texto[UI_TEXTO_MAX] = '\0';
+  rotulo->sujo = true;
+}
+
+void ui_rotulo_invalidar(ui_rotulo_t *rotulo)
+{
+  rotulo->sujo = true;
+}
+
+// Apaga a área e desenha o texto, se ele mudou. Retorna true se desenhou.
+bool ui_rotulo_desenhar(ui_rotulo_t *rotulo, ssd1306_t *ssd)
+{
+  if (!rotulo->sujo)
+    return false;
+  rotulo->sujo = false;
+
+  ssd1306_rect(ssd, rotulo->x, rotulo->y, rotulo->largura, rotulo->altura, false, true);
+  if (ssd1306_string_width(rotulo->texto) <= rotulo->largura)
+  {
+    ssd1306_draw_string_cached(ssd, rotulo->texto, rotulo->x, rotulo->y);
+    return true;
+  }
+
+  // Quebra em linhas de largura / 8 caracteres; o que não cabe na área é cortado
+  uint8_t colunas = rotulo->largura / 8, linhas = rotulo->altura / 8;
+  const char *c = rotulo->texto;
+  for (uint8_t l = 0; l < linhas && *c; l++)
+  {
+    for (uint8_t col = 0; col < colunas && *c; col++)
+      ssd1306_draw_char(ssd, *c++, rotulo->x + col * 8, rotulo->y + l * 8);
+  }
+  return true;
+}
+
+// Monta o contorno da seleção como sprite (a máscara é o próprio contorno, então o
+// caractere da tecla fica intacto) e guarda as variantes deslocadas
+static void ui_teclado_cursor_init(ui_teclado_t *teclado)
+{
+  uint8_t largura = teclado->largura, altura = teclado->altura;
+  teclado->cursor_pronto = false;
+  if (largura > UI_CURSOR_LARGURA_MAX || altura > UI_CURSOR_ALTURA_MAX || !largura || !altura)
+    return;
+
+  memset(teclado->cursor_bits, 0, sizeof(teclado->cursor_bits));
+  for (uint8_t y = 0; y < altura; y++)
+  {
+    for (uint8_t x = 0; x < largura; x++)
+    {
+      if (x == 0 || x == largura - 1 || y == 0 || y == altura - 1)
+        teclado->cursor_bits[(y / 8) * largura + x] |= 1u << (y % 8);
+    }
+  }
+  teclado->cursor.width = largura;
+  teclado->cursor.height = altura;
+  teclado->cursor.bits = teclado->cursor_bits;
+  teclado->cursor.mask = teclado->cursor_bits;
+  teclado->cursor_pronto = ssd1306_sprite_cache_init(&teclado->cursor_cache, &teclado->cursor,
+                                                     teclado->cursor_variantes, sizeof(teclado->cursor_variantes));
+}
+
+// Prepara o teclado ocupando a tela toda: teclas de WIDTH / colunas por HEIGHT / linhas pixels
+void ui_teclado_init(ui_teclado_t *teclado, const char *teclas, uint8_t colunas, uint8_t linhas)
+{
+  teclado->teclas = teclas;
+  teclado->colunas = colunas;
+  teclado->linhas = linhas;
+  teclado->passo_x = WIDTH / colunas;
+  teclado->passo_y = HEIGHT / linhas;
+  teclado->largura = teclado->passo_x - 2;
+  teclado->altura = teclado->passo_y - 1;
+  teclado->texto_dx = 10;
+  teclado->texto_dy = 5;
+  teclado->moldura = 2;
+  teclado->sel_x = teclado->desenhada_x = 0;
+  teclado->sel_y = teclado->desenhada_y = 0;
+  teclado->completo = false;
+  ui_teclado_cursor_init(teclado);
+}
+
+void ui_teclado_selecionar(ui_teclado_t *teclado, uint8_t x, uint8_t y)
+{
+  teclado->sel_x = x;
+  teclado->sel_y = y;
+}
+
+void ui_teclado_invalidar(ui_teclado_t *teclado)
+{
+  teclado->completo = false;
+}
+
+static void ui_teclado_moldura(const ui_teclado_t *teclado, ssd1306_t *ssd)
+{
+  for (uint8_t i = 0; i < teclado->moldura; i++)
+    ssd1306_rect(ssd, i, i, ssd->width - (2 * i), ssd->height - (2 * i), true, false);
+}
+
+// Redesenha só o trecho da moldura que cai dentro do retângulo de seleção (x, y)
+static void ui_teclado_moldura_sob(const ui_teclado_t *teclado, ssd1306_t *ssd, uint8_t x, uint8_t y)
+{
+  uint8_t x0 = x * teclado->passo_x, y0 = y * teclado->passo_y;
+  uint8_t x1 = x0 + teclado->largura - 1, y1 = y0 + teclado->altura - 1;
+  for (uint8_t i = 0; i < teclado->moldura; i++)
+  {
+    uint8_t esquerda = i, direita = ssd->width - 1 - i;
+    uint8_t topo = i, base = ssd->height - 1 - i;
+    uint8_t ini_x = x0 > esquerda ? x0 : esquerda, fim_x = x1 < direita ? x1 : direita;
+    uint8_t ini_y = y0 > topo ? y0 : topo, fim_y = y1 < base ? y1 : base;
+    if (ini_x > fim_x || ini_y > fim_y)
+      continue;
+    if (topo >= y0 && topo <= y1)
+      ssd1306_hline(ssd, ini_x, topo, fim_x - ini_x + 1, true);
+    if (base >= y0 && base <= y1)
+      ssd1306_hline(ssd, ini_x, base, fim_x - ini_x + 1, true);
+    if (esquerda >= x0 && esquerda <= x1)
+      ssd1306_vline(ssd, esquerda, ini_y, fim_y - ini_y + 1, true);
+    if (direita >= x0 && direita <= x1)
+      ssd1306_vline(ssd, direita, ini_y, fim_y - ini_y + 1, true);
+  }
+}
+
+static void ui_teclado_selecao(const ui_teclado_t *teclado, ssd1306_t *ssd, uint8_t x, uint8_t y, bool valor)
+{
+  uint8_t px = x * teclado->passo_x, py = y * teclado->passo_y;
+  if (!teclado->cursor_pronto)
+    ssd1306_rect(ssd, px, py, teclado->largura, teclado->altura, valor, false);
+  else if (valor)
+    ssd1306_draw_sprite_cached(ssd, &teclado->cursor_cache, px, py);
+  else
+    ssd1306_erase_sprite_cached(ssd, &teclado->cursor_cache, px, py);
+}
+
+// Desenha o teclado inteiro se ele foi invalidado; senão, se a seleção mudou, apaga só o
+// retângulo antigo (refazendo o trecho da moldura que ele cobria) e desenha o novo.
+// Retorna true se desenhou algo.
+bool ui_teclado_desenhar(ui_teclado_t *teclado, ssd1306_t *ssd)
+{
+  if (!teclado->completo)
+  {
+    ssd1306_rect(ssd, 0, 0, teclado->colunas * teclado->passo_x, teclado->linhas * teclado->passo_y, false, true);
+    ui_teclado_moldura(teclado, ssd);
+    for (uint8_t l = 0; l < teclado->linhas; l++)
+    {
+      for (uint8_t c = 0; c < teclado->colunas; c++)
+      {
+        ssd1306_draw_char(ssd, teclado->teclas[l * teclado->colunas + c], c * teclado->passo_x + teclado->texto_dx,
+                          l * teclado->passo_y + teclado->texto_dy);
+      }
+    }
+  }
+  else if (teclado->sel_x != teclado->desenhada_x || teclado->sel_y != teclado->desenhada_y)
+  {
+    ui_teclado_selecao(teclado, ssd, teclado->desenhada_x, teclado->desenhada_y, false);
+    ui_teclado_moldura_sob(teclado, ssd, teclado->desenhada_x, teclado->desenhada_y);
+  }
+  else
+  {
+    return false;
+  }
+
+  ui_teclado_selecao(teclado, ssd, teclado->sel_x, teclado->sel_y, true);
+  teclado->desenhada_x = teclado->sel_x;
+  teclado->desenhada_y = teclado->sel_y;
+  teclado->completo = true;
+  return true;
+}
+
+// Prepara a barra de status na linha y, até a borda direita da tela
+void ui_barra_init(ui_barra_t *barra, uint8_t y)
+{
+  ui_rotulo_init(&barra->rotulo, 0, y + 2, WIDTH, HEIGHT - y - 2);
+  barra->traco = false;
+  barra->sujo = true;
+}
+
+void ui_barra_definir(ui_barra_t *barra, const char *texto)
+{
+  ui_rotulo_definir(&barra->rotulo, texto);
+}
+
+void ui_barra_invalidar(ui_barra_t *barra)
+{
+  barra->sujo = true;
+  ui_rotulo_invalidar(&barra->rotulo);
+}
+
+// Desenha ou apaga o traço separador, se ele mudou, e o texto, se mudou
+bool ui_barra_desenhar(ui_barra_t *barra, ssd1306_t *ssd)
+{
+  bool desenhou = false;
+  bool traco = barra->rotulo.texto[0] != '\0';
+  if (barra->sujo || traco != barra->traco)
+  {
+    ssd1306_hline(ssd, barra->rotulo.x, barra->rotulo.y - 2, barra->rotulo.largura, traco);
+    barra->traco = traco;
+    barra->sujo = false;
+    desenhou = true;
+  }
+  return ui_rotulo_desenhar(&barra->rotulo, ssd) || desenhou;
+}
+
+// Prepara uma área de imagem vazia com o canto superior esquerdo em (x, y)
+void ui_imagem_init(ui_imagem_t *imagem, uint8_t x, uint8_t y)
+{
+  imagem->x = x;
+  imagem->y = y;
+  imagem->imagem = NULL;
+  imagem->desenhada = NULL;
+  imagem->sujo = true;
+}
+
+// Troca a imagem; a mesma imagem não causa redesenho
+void ui_imagem_definir(ui_imagem_t *imagem, const ssd1306_image_t *nova)
+{
+  if (nova == imagem->imagem)
+    return;
+  imagem->imagem = nova;
+  imagem->sujo = true;
+}
+
+// A área foi apagada por quem chamou: não há imagem antiga a apagar
+void ui_imagem_invalidar(ui_imagem_t *imagem)
+{
+  imagem->desenhada = NULL;
+  imagem->sujo = true;
+}
+
+// Apaga a imagem anterior e desenha a nova, se ela mudou. Retorna true se desenhou.
+bool ui_imagem_desenhar(ui_imagem_t *imagem, ssd1306_t *ssd)
+{
+  if (!imagem->sujo)
+    return false;
+  imagem->sujo = false;
+
+  if (imagem->desenhada)
+    ssd1306_rect(ssd, imagem->x, imagem->y, imagem->desenhada->width, imagem->desenhada->height, false, true);
+  if (imagem->imagem)
+    ssd1306_draw_image(ssd, imagem->imagem, imagem->x, imagem->y);
+  imagem->desenhada = imagem->imagem;
+  return true;
+}
@@ -0,0 +1,81 @@
+#ifndef UI_H
+#define UI_H
+
+#include "ssd1306.h"
+
+// Widgets que guardam o próprio estado e só desenham o que mudou desde o último
+// desenho. Quem troca de tela limpa o display e chama ui_*_invalidar nos widgets da
+// nova tela; depois disso, ui_*_desenhar não faz nada enquanto o estado não mudar.
+
+#define UI_TEXTO_MAX 24
+#define UI_CURSOR_LARGURA_MAX 48 // Maior retângulo de seleção desenhado como sprite
+#define UI_CURSOR_ALTURA_MAX 16
+
+// Texto numa área fixa; proporcional se couber numa linha, senão quebra em 8 pixels por caractere dentro da área
+typedef struct
+{
+  uint8_t x, y, largura, altura;
+  char texto[UI_TEXTO_MAX + 1];
+  bool sujo;
+} ui_rotulo_t;
+
+// Grade de teclas com uma moldura em volta e um retângulo na tecla selecionada. O
+// retângulo é um sprite com as variantes deslocadas em cache, então mover a seleção custa
+// alguns bytes por coluna; se não couber em UI_CURSOR_*_MAX, é desenhado com ssd1306_rect.
+typedef struct
+{
+  const char *teclas; // linhas * colunas caracteres, linha a linha
+  uint8_t colunas, linhas;
+  uint8_t passo_x, passo_y;       // Distância entre teclas vizinhas
+  uint8_t largura, altura;        // Retângulo de seleção
+  uint8_t texto_dx, texto_dy;     // Posição do caractere dentro da tecla
+  uint8_t moldura;                // Espessura da moldura em volta da tela (0 = sem moldura)
+  uint8_t sel_x, sel_y;           // Seleção pedida
+  uint8_t desenhada_x, desenhada_y; // Seleção que está no framebuffer
+  bool completo;                  // Teclas e moldura já estão no framebuffer
+  uint8_t cursor_bits[UI_CURSOR_LARGURA_MAX * ((UI_CURSOR_ALTURA_MAX + 7) / 8)]; // Contorno da seleção
+  ssd1306_sprite_t cursor;
+  ssd1306_sprite_cache_t cursor_cache;
+  uint8_t cursor_variantes[SSD1306_SPRITE_CACHE_SIZE(UI_CURSOR_LARGURA_MAX, UI_CURSOR_ALTURA_MAX)];
+  bool cursor_pronto; // cursor_cache pode ser usado
+} ui_teclado_t;
+
+// Linha de status no rodapé: um traço separador e um texto proporcional. Sem texto,
+// o traço também some.
+typedef struct
+{
+  ui_rotulo_t rotulo;
+  bool traco; // O traço está no framebuffer
+  bool sujo;  // O traço precisa ser redesenhado
+} ui_barra_t;
+
+// Imagem comprimida numa posição fixa; trocar a imagem apaga a área da anterior
+typedef struct
+{
+  uint8_t x, y;
+  const ssd1306_image_t *imagem;    // Imagem pedida (NULL = nenhuma)
+  const ssd1306_image_t *desenhada; // Imagem que está no framebuffer
+  bool sujo;
+} ui_imagem_t;
+
+void ui_rotulo_init(ui_rotulo_t *rotulo, uint8_t x, uint8_t y, uint8_t largura, uint8_t altura);
+void ui_rotulo_definir(ui_rotulo_t *rotulo, const char *texto);
+void ui_rotulo_invalidar(ui_rotulo_t *rotulo);
+bool ui_rotulo_desenhar(ui_rotulo_t *rotulo, ssd1306_t *ssd);
+
+void ui_teclado_init(ui_teclado_t *teclado, const char *teclas, uint8_t colunas, uint8_t linhas);
+void ui_teclado_selecionar(ui_teclado_t *teclado, uint8_t x, uint8_t y);
+void ui_teclado_invalidar(ui_teclado_t *teclado);
+bool ui_teclado_desenhar(ui_teclado_t *teclado, ssd1306_t *ssd);
+
+void ui_barra_init(ui_barra_t *barra, uint8_t y);
+void ui_barra_definir(ui_barra_t *barra, const char *texto);
+void ui_barra_invalidar(ui_barra_t *barra);
+bool ui_barra_desenhar(ui_barra_t *barra, ssd1306_t *ssd);
+
+void ui_imagem_init(ui_imagem_t *imagem, uint8_t x, uint8_t y);
+void ui_imagem_definir(ui_imagem_t *imagem, const ssd1306_image_t *nova);
+void ui_imagem_invalidar(ui_imagem_t *imagem);
+bool ui_imagem_desenhar(ui_imagem_t *imagem, ssd1306_t *ssd);
+
+#endif // UI_H
@@ -0,0 +1,389 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "lib/ssd1306.h"
+#include "lib/ui.h"
+#include "lib/imagens.h"
+
+// Micro-benchmarks das primitivas de desenho do SSD1306 sobre o ram_buffer, sem envio
+// pelo I2C. Para cada caso mede ns por operação e pixels por segundo e imprime um JSON
+// com um objeto por caso, para comparar versões.
+//
+// Uso: bench_ssd1306 [-t tempo_minimo_ms] [-o resultado.json]
+
+#define LARGURA 128
+#define ALTURA 64
+#define POSICOES 1024 // Tamanho da tabela de coordenadas pseudoaleatórias
+
+typedef struct
+{
+  const char *primitiva;
+  const char *variante;
+  uint32_t pixels; // Pixels tocados por operação
+  void (*executar)(ssd1306_t *ssd, uint32_t i);
+} caso_t;
+
+static uint8_t posicoes_x[POSICOES], posicoes_y[POSICOES];
+
+// ---------------------------------------------------------------------------------------
+// Casos
+
+static void pixel_aleatorio(ssd1306_t *ssd, uint32_t i)
+{
+  ssd1306_pixel(ssd, posicoes_x[i % POSICOES], posicoes_y[i % POSICOES], i & 1);
+}
+
+static void fill_apagar(ssd1306_t *ssd, uint32_t i)
+{
+  (void)i;
+  ssd1306_fill(ssd, false);
+}
+
+static void fill_acender(ssd1306_t *ssd, uint32_t i)
+{
+  (void)i;
+  ssd1306_fill(ssd, true);
+}
+
+static void rect_8x8_alinhado(ssd1306_t *ssd, uint32_t i)
+{
+  ssd1306_rect(ssd, (i * 8) % LARGURA, 8, 8, 8, i & 1, false);
+}
+
+static void rect_8x8_desalinhado(ssd1306_t *ssd, uint32_t i)
+{
+  ssd1306_rect(ssd, (i * 8) % LARGURA, 11, 8, 8, i & 1, false);
+}
+
+static void rect_40x15_teclado(ssd1306_t *ssd, uint32_t i)
+{
+  ssd1306_rect(ssd, (i % 3) * 42, (i % 4) * 16, 40, 15, i & 1, false);
+}
+
+static void rect_tela_borda(ssd1306_t *ssd, uint32_t i)
+{
+  ssd1306_rect(ssd, 0, 0, LARGURA, ALTURA, i & 1, false);
+}
+
+static void rect_8x8_cheio_alinhado(ssd1306_t *ssd, uint32_t i)
+{
+  ssd1306_rect(ssd, (i * 8) % LARGURA, 8, 8, 8, i & 1, true);
+}
+
+static void rect_8x8_cheio_desalinhado(ssd1306_t *ssd, uint32_t i)
+{
+  ssd1306_rect(ssd, (i * 8) % LARGURA, 11, 8, 8, i & 1, true);
+}
+
+static void rect_32x16_cheio(ssd1306_t *ssd, uint32_t i)
+{
+  ssd1306_rect(ssd, (i * 32) % LARGURA, 20, 32, 16, i & 1, true);
+}
+
+static void rect_tela_cheio(ssd1306_t *ssd, uint32_t i)
+{
+  ssd1306_rect(ssd, 0, 0, LARGURA, ALTURA, i & 1, true);
+}
+
+static void line_horizontal(ssd1306_t *ssd, uint32_t i)
+{
+  ssd1306_line(ssd, 0, i % ALTURA, LARGURA - 1, i % ALTURA, i & 1);
+}
+
+static void line_vertical(ssd1306_t *ssd, uint32_t i)
+{
+  ssd1306_line(ssd, i % LARGURA, 0, i % LARGURA, ALTURA - 1, i & 1);
+}
+
+static void line_diagonal(ssd1306_t *ssd, uint32_t i)
+{
+  ssd1306_line(ssd, i % 64, 0, i % 64 + 63, 63, i & 1);
+}
+
+static void line_inclinada(ssd1306_t *ssd, uint32_t i)
+{
+  ssd1306_line(ssd, 0, i % 44, LARGURA - 1, i % 44 + 20, i & 1);
+}
+
+static void char_alinhado(ssd1306_t *ssd, uint32_t i)
+{
+  ssd1306_draw_char(ssd, '0' + i % 10, (i * 8) % LARGURA, 8);
+}
+
+static void char_desalinhado(ssd1306_t *ssd, uint32_t i)
+{
+  ssd1306_draw_char(ssd, '0' + i % 10, (i * 8) % LARGURA, 13);
+}
+
+static void string_alinhada(ssd1306_t *ssd, uint32_t i)
+{
+  (void)i;
+  ssd1306_draw_string(ssd, "ACESSO LIBERADO!", 0, 0);
+}
+
+static void string_desalinhada(ssd1306_t *ssd, uint32_t i)
+{
+  (void)i;
+  ssd1306_draw_string(ssd, "ACESSO LIBERADO!", 0, 5);
+}
+
+static void string_prop_alinhada(ssd1306_t *ssd, uint32_t i)
+{
+  (void)i;
+  ssd1306_draw_string_prop(ssd, "ACESSO LIBERADO!", 0, 0);
+}
+
+static void string_prop_desalinhada(ssd1306_t *ssd, uint32_t i)
+{
+  (void)i;
+  ssd1306_draw_string_prop(ssd, "ACESSO LIBERADO!", 0, 5);
+}
+
+static void string_cache_alinhada(ssd1306_t *ssd, uint32_t i)
+{
+  (void)i;
+  ssd1306_draw_string_cached(ssd, "ACESSO LIBERADO!", 0, 0);
+}
+
+static void string_cache_desalinhada(ssd1306_t *ssd, uint32_t i)
+{
+  (void)i;
+  ssd1306_draw_string_cached(ssd, "ACESSO LIBERADO!", 0, 5);
+}
+
+// Ícone de 32x32 descomprimido da tabela de imagens direto para o buffer
+static void imagem_alinhada(ssd1306_t *ssd, uint32_t i)
+{
+  ssd1306_draw_image(ssd, &imagem_cadeado_fechado, posicoes_x[i % POSICOES] % (LARGURA - 31), 16);
+}
+
+static void imagem_desalinhada(ssd1306_t *ssd, uint32_t i)
+{
+  ssd1306_draw_image(ssd, &imagem_cadeado_fechado, posicoes_x[i % POSICOES] % (LARGURA - 31), 13);
+}
+
+// Sprite de 16x16: um anel opaco sobre um disco (a máscara), o resto transparente
+static uint8_t sprite_bits[32], sprite_mascara[32];
+static const ssd1306_sprite_t sprite = {16, 16, sprite_bits, sprite_mascara};
+static ssd1306_sprite_cache_t sprite_cache;
+static uint8_t sprite_variantes[SSD1306_SPRITE_CACHE_SIZE(16, 16)];
+
+static void preparar_sprite(void)
+{
+  for (int y = 0; y < 16; y++)
+  {
+    for (int x = 0; x < 16; x++)
+    {
+      int d = (2 * x - 15) * (2 * x - 15) + (2 * y - 15) * (2 * y - 15); // (2r)² a partir do centro
+      if (d <= 256)
+        sprite_mascara[(y / 8) * 16 + x] |= 1u << (y % 8);
+      if (d <= 256 && d >= 144)
+        sprite_bits[(y / 8) * 16 + x] |= 1u << (y % 8);
+    }
+  }
+  ssd1306_sprite_cache_init(&sprite_cache, &sprite, sprite_variantes, sizeof(sprite_variantes));
+}
+
+// Sprite deslocando os bits na hora, em y qualquer
+static void sprite_direto(ssd1306_t *ssd, uint32_t i)
+{
+  ssd1306_draw_sprite(ssd, &sprite, posicoes_x[i % POSICOES] % (LARGURA - 15), posicoes_y[i % POSICOES] % (ALTURA - 15));
+}
+
+// Mesmo sprite pelas variantes pré-deslocadas
+static void sprite_cache_desenhar(ssd1306_t *ssd, uint32_t i)
+{
+  ssd1306_draw_sprite_cached(ssd, &sprite_cache, posicoes_x[i % POSICOES] % (LARGURA - 15),
+                             posicoes_y[i % POSICOES] % (ALTURA - 15));
+}
+
+// Sprite andando um pixel na diagonal: apaga na posição anterior e desenha na nova
+static void sprite_cache_mover(ssd1306_t *ssd, uint32_t i)
+{
+  uint8_t x = i % (LARGURA - 16), y = i % (ALTURA - 16);
+  ssd1306_erase_sprite_cached(ssd, &sprite_cache, x, y);
+  ssd1306_draw_sprite_cached(ssd, &sprite_cache, x + 1, y + 1);
+}
+
+static const char teclado[4][3] = {{'1', '2', '3'}, {'4', '5', '6'}, {'7', '8', '9'}, {'*', '0', '#'}};
+
+// Teclado numérico redesenhado inteiro a cada movimento do cursor
+static void tela_teclado(ssd1306_t *ssd, uint32_t i)
+{
+  uint8_t cursor = i % 12;
+
+  ssd1306_fill(ssd, false);
+  for (int b = 0; b < 2; b++)
+    ssd1306_rect(ssd, b, b, LARGURA - (2 * b), ALTURA - (2 * b), true, false);
+  for (uint8_t l = 0; l < 4; l++)
+  {
+    for (uint8_t c = 0; c < 3; c++)
+    {
+      uint8_t x = c * 42;
+      uint8_t y = l * 16;
+      ssd1306_draw_char(ssd, teclado[l][c], x + 10, y + 5);
+      if (l * 3 + c == cursor)
+        ssd1306_rect(ssd, x, y, 40, 15, true, false);
+    }
+  }
+}
+
+// Tela de mensagem redesenhada inteira
+static void tela_mensagem(ssd1306_t *ssd, uint32_t i)
+{
+  (void)i;
+  ssd1306_fill(ssd, false);
+  ssd1306_draw_string_cached(ssd, "SENHA INCORRETA!", 0, 0);
+}
+
+// Teclado do firmware (lib/ui.h): a cada movimento do cursor só troca o retângulo de seleção
+static void ui_teclado_cursor(ssd1306_t *ssd, uint32_t i)
+{
+  static ui_teclado_t ui;
+  if (!ui.teclas)
+  {
+    ui_teclado_init(&ui, &teclado[0][0], 3, 4);
+    ui_teclado_desenhar(&ui, ssd);
+  }
+  ui_teclado_selecionar(&ui, i % 3, (i / 3) % 4);
+  ui_teclado_desenhar(&ui, ssd);
+}
+
+// Teclado do firmware pedido de novo sem mudança: não desenha nada
+static void ui_teclado_parado(ssd1306_t *ssd, uint32_t i)
+{
+  static ui_teclado_t ui;
+  (void)i;
+  if (!ui.teclas)
+    ui_teclado_init(&ui, &teclado[0][0], 3, 4);
+  ui_teclado_desenhar(&ui, ssd);
+}
+
+static const caso_t casos[] = {
+    {"pixel", "aleatorio", 1, pixel_aleatorio},
+    {"fill", "apagar", LARGURA * ALTURA, fill_apagar},
+    {"fill", "acender", LARGURA * ALTURA, fill_acender},
+    {"rect", "8x8_alinhado", 28, rect_8x8_alinhado},
+    {"rect", "8x8_desalinhado", 28, rect_8x8_desalinhado},
+    {"rect", "40x15_teclado", 106, rect_40x15_teclado},
+    {"rect", "128x64_borda", 380, rect_tela_borda},
+    {"rect_cheio", "8x8_alinhado", 64, rect_8x8_cheio_alinhado},
+    {"rect_cheio", "8x8_desalinhado", 64, rect_8x8_cheio_desalinhado},
+    {"rect_cheio", "32x16", 512, rect_32x16_cheio},
+    {"rect_cheio", "128x64", LARGURA * ALTURA, rect_tela_cheio},
+    {"line", "horizontal_128", 128, line_horizontal},
+    {"line", "vertical_64", 64, line_vertical},
+    {"line", "diagonal_64", 64, line_diagonal},
+    {"line", "inclinada_128x21", 128, line_inclinada},
+    {"draw_char", "alinhado", 64, char_alinhado},
+    {"draw_char", "desalinhado", 64, char_desalinhado},
+    {"draw_string", "16_alinhada", 16 * 64, string_alinhada},
+    {"draw_string", "16_desalinhada", 16 * 64, string_desalinhada},
+    {"draw_string_prop", "16_alinhada", 109 * 8, string_prop_alinhada},
+    {"draw_string_prop", "16_desalinhada", 109 * 8, string_prop_desalinhada},
+    {"draw_string_cached", "16_alinhada", 109 * 8, string_cache_alinhada},
+    {"draw_string_cached", "16_desalinhada", 109 * 8, string_cache_desalinhada},
+    {"draw_image", "32x32_alinhada", 32 * 32, imagem_alinhada},
+    {"draw_image", "32x32_desalinhada", 32 * 32, imagem_desalinhada},
+    {"draw_sprite", "16x16_direto", 16 * 16, sprite_direto},
+    {"draw_sprite", "16x16_cache", 16 * 16, sprite_cache_desenhar},
+    {"draw_sprite", "16x16_cache_mover", 2 * 16 * 16, sprite_cache_mover},
+    {"tela", "teclado", LARGURA * ALTURA, tela_teclado},
+    {"tela", "mensagem", LARGURA * ALTURA, tela_mensagem},
+    {"ui_teclado", "cursor", 2 * 106, ui_teclado_cursor},
+    {"ui_teclado", "sem_mudanca", 0, ui_teclado_parado},
+};
+
+// ---------------------------------------------------------------------------------------
+
+static uint64_t agora_ns(void)
+{
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return (uint64_t)t.tv_sec * 1000000000ull + (uint64_t)t.tv_nsec;
+}
+
+// Repete o caso em lotes que dobram de tamanho até somar o tempo mínimo
+static double medir_ns_por_op(ssd1306_t *ssd, const caso_t *caso, uint64_t minimo_ns, uint64_t *operacoes)
+{
+  uint32_t lote = 16;
+  uint64_t total_ns = 0, total_ops = 0;
+  uint32_t i = 0;
+
+  for (uint32_t aquecimento = 0; aquecimento < 64; aquecimento++)
+    caso->executar(ssd, i++);
+
+  while (total_ns < minimo_ns)
+  {
+    uint64_t inicio = agora_ns();
+    for (uint32_t n = 0; n < lote; n++)
+      caso->executar(ssd, i++);
+    total_ns += agora_ns() - inicio;
+    total_ops += lote;
+    if (lote < (1u << 20))
+      lote *= 2;
+  }
+  *operacoes = total_ops;
+  return (double)total_ns / (double)total_ops;
+}
+
+int main(int argc, char **argv)
+{
+  uint64_t minimo_ms = 100;
+  const char *arquivo = NULL;
+
+  for (int i = 1; i < argc; i++)
+  {
+    if (strcmp(argv[i], "-t") == 0 && i + 1 < argc)
+      minimo_ms = strtoull(argv[++i], NULL, 10);
+    else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+      arquivo = argv[++i];
+    else
+    {
+      fprintf(stderr, "uso: %s [-t tempo_minimo_ms] [-o resultado.json]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  // Coordenadas fixas (gerador congruente) para que todas as execuções desenhem o mesmo
+  uint32_t semente = 12345;
+  for (int i = 0; i < POSICOES; i++)
+  {
+    semente = semente * 1103515245u + 12345u;
+    posicoes_x[i] = (semente >> 16) % LARGURA;
+    semente = semente * 1103515245u + 12345u;
+    posicoes_y[i] = (semente >> 16) % ALTURA;
+  }
+  preparar_sprite();
+
+  ssd1306_t ssd;
+  ssd1306_init(&ssd, LARGURA, ALTURA, false, 0x3C, i2c1);
+
+  FILE *saida = stdout;
+  if (arquivo && !(saida = fopen(arquivo, "w")))
+  {
+    perror(arquivo);
+    return 1;
+  }
+
+  size_t total = sizeof(casos) / sizeof(casos[0]);
+  fprintf(saida, "[\n");
+  for (size_t i = 0; i < total; i++)
+  {
+    const caso_t *caso = &casos[i];
+    uint64_t operacoes;
+    ssd1306_fill(&ssd, false);
+    double ns = medir_ns_por_op(&ssd, caso, minimo_ms * 1000000ull, &operacoes);
+    fprintf(saida,
+            "  {\"primitiva\": \"%s\", \"variante\": \"%s\", \"ns_por_op\": %.1f, \"pixels_por_s\": %.0f, "
+            "\"operacoes\": %llu}%s\n",
+            caso->primitiva, caso->variante, ns, caso->pixels * 1e9 / ns, (unsigned long long)operacoes,
+            i + 1 < total ? "," : "");
+  }
+  fprintf(saida, "]\n");
+
+  if (saida != stdout)
+    fclose(saida);
+  return 0;
+}
@@ -0,0 +1,24 @@
+#ifndef SIM_HARDWARE_CLOCKS_H
+#define SIM_HARDWARE_CLOCKS_H
+
+// Substituto de hardware/clocks.h com as frequências padrão do RP2040
+
+#include "pico/types.h"
+
+enum clock_index
+{
+  clk_gpout0 = 0,
+  clk_gpout1,
+  clk_gpout2,
+  clk_gpout3,
+  clk_ref,
+  clk_sys,
+  clk_peri,
+  clk_usb,
+  clk_adc,
+  clk_rtc
+};
+
+uint32_t clock_get_hz(enum clock_index clk_index);
+
+#endif // SIM_HARDWARE_CLOCKS_H
@@ -0,0 +1,60 @@
+#ifndef SIM_HARDWARE_DMA_H
+#define SIM_HARDWARE_DMA_H
+
+// Substituto de hardware/dma.h. Transferências para o I2C e o PIO são consumidas na hora
+// e o canal fica ocupado pelo tempo que o periférico levaria; as do ADC avançam a cada
+// conversão; as demais são cópias imediatas.
+
+#include "pico/types.h"
+
+#define NUM_DMA_CHANNELS 12
+#define DREQ_FORCE 0x3f
+
+enum dma_channel_transfer_size
+{
+  DMA_SIZE_8 = 0,
+  DMA_SIZE_16 = 1,
+  DMA_SIZE_32 = 2
+};
+
+typedef struct
+{
+  enum dma_channel_transfer_size tamanho;
+  bool incrementar_leitura;
+  bool incrementar_escrita;
+  bool anel_na_escrita;
+  uint8_t anel_bits; // 0 = sem anel
+  uint8_t dreq;
+  uint8_t encadear;  // Igual ao próprio canal = sem encadeamento
+} dma_channel_config;
+
+// Os endereços ocupam uintptr_t (e não 32 bits como no RP2040) para caber ponteiros do computador
+typedef struct
+{
+  volatile uintptr_t read_addr;
+  volatile uintptr_t write_addr;
+  volatile uint32_t transfer_count;
+  volatile uint32_t al1_transfer_count_trig;
+} dma_channel_hw_t;
+
+int dma_claim_unused_channel(bool required);
+void dma_channel_unclaim(uint channel);
+dma_channel_hw_t *dma_channel_hw_addr(uint channel);
+
+dma_channel_config dma_channel_get_default_config(uint channel);
+void channel_config_set_transfer_data_size(dma_channel_config *c, enum dma_channel_transfer_size size);
+void channel_config_set_read_increment(dma_channel_config *c, bool incr);
+void channel_config_set_write_increment(dma_channel_config *c, bool incr);
+void channel_config_set_dreq(dma_channel_config *c, uint dreq);
+void channel_config_set_ring(dma_channel_config *c, bool write, uint size_bits);
+void channel_config_set_chain_to(dma_channel_config *c, uint chain_to);
+
+void dma_channel_configure(uint channel, const dma_channel_config *config, volatile void *write_addr,
+                           const volatile void *read_addr, uint transfer_count, bool trigger);
+void dma_channel_set_read_addr(uint channel, const volatile void *read_addr, bool trigger);
+void dma_channel_start(uint channel);
+bool dma_channel_is_busy(uint channel);
+void dma_channel_abort(uint channel);
+void dma_channel_wait_for_finish_blocking(uint channel);
+
+#endif // SIM_HARDWARE_DMA_H
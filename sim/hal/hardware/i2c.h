@@ -0,0 +1,51 @@
+#ifndef SIM_HARDWARE_I2C_H
+#define SIM_HARDWARE_I2C_H
+
+// Substituto de hardware/i2c.h. Cada transação é entregue ao dispositivo simulado no
+// endereço de destino e o tempo de barramento é calculado a partir da frequência do I2C.
+
+#include "pico/types.h"
+
+typedef struct
+{
+  volatile uint32_t enable;
+  volatile uint32_t tar;
+  volatile uint32_t data_cmd;
+  volatile uint32_t status;
+  volatile uint32_t raw_intr_stat;
+  volatile uint32_t clr_tx_abrt;
+} i2c_hw_t;
+
+typedef struct i2c_inst
+{
+  i2c_hw_t *hw;
+  uint baudrate;
+  bool nack; // A última transação não teve dispositivo no endereço
+} i2c_inst_t;
+
+extern i2c_inst_t sim_i2c0_inst, sim_i2c1_inst;
+#define i2c0 (&sim_i2c0_inst)
+#define i2c1 (&sim_i2c1_inst)
+
+#define I2C_IC_DATA_CMD_STOP_BITS 0x00000200u
+#define I2C_IC_STATUS_TFE_BITS 0x00000004u
+#define I2C_IC_STATUS_MST_ACTIVITY_BITS 0x00000020u
+#define I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS 0x00000040u
+
+#define DREQ_I2C0_TX 32
+#define DREQ_I2C0_RX 33
+#define DREQ_I2C1_TX 34
+#define DREQ_I2C1_RX 35
+
+static inline i2c_hw_t *i2c_get_hw(i2c_inst_t *i2c) { return i2c->hw; }
+static inline uint i2c_hw_index(i2c_inst_t *i2c) { return i2c == i2c1 ? 1 : 0; }
+
+static inline uint i2c_get_dreq(i2c_inst_t *i2c, bool is_tx)
+{
+  return i2c == i2c0 ? (is_tx ? DREQ_I2C0_TX : DREQ_I2C0_RX) : (is_tx ? DREQ_I2C1_TX : DREQ_I2C1_RX);
+}
+
+uint i2c_init(i2c_inst_t *i2c, uint baudrate);
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop);
+
+#endif // SIM_HARDWARE_I2C_H
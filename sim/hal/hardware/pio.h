@@ -0,0 +1,94 @@
+#ifndef SIM_HARDWARE_PIO_H
+#define SIM_HARDWARE_PIO_H
+
+// Substituto de hardware/pio.h. O programa não é executado: cada palavra enviada a uma
+// máquina de estados é contabilizada e ocupa o tempo que o programa levaria para
+// deslocá-la, calculado com o divisor e o limiar de autopull configurados.
+
+#include "pico/types.h"
+#include "hardware/gpio.h"
+
+typedef struct
+{
+  volatile uint32_t txf[4];
+} pio_hw_t;
+
+typedef pio_hw_t *PIO;
+
+extern pio_hw_t sim_pio0_hw, sim_pio1_hw;
+#define pio0 (&sim_pio0_hw)
+#define pio1 (&sim_pio1_hw)
+
+struct pio_program
+{
+  const uint16_t *instructions;
+  uint8_t length;
+  int8_t origin;
+  uint8_t pio_version;
+};
+
+typedef struct
+{
+  float clkdiv;
+  uint8_t bits_por_palavra; // Limiar de autopull (0 = 32)
+} pio_sm_config;
+
+enum pio_fifo_join
+{
+  PIO_FIFO_JOIN_NONE = 0,
+  PIO_FIFO_JOIN_TX = 1,
+  PIO_FIFO_JOIN_RX = 2
+};
+
+static inline pio_sm_config pio_get_default_sm_config(void)
+{
+  pio_sm_config c = {1.0f, 32};
+  return c;
+}
+
+static inline void sm_config_set_wrap(pio_sm_config *c, uint wrap_target, uint wrap)
+{
+  (void)c;
+  (void)wrap_target;
+  (void)wrap;
+}
+
+static inline void sm_config_set_sideset(pio_sm_config *c, uint bit_count, bool optional, bool pindirs)
+{
+  (void)c;
+  (void)bit_count;
+  (void)optional;
+  (void)pindirs;
+}
+
+static inline void sm_config_set_sideset_pins(pio_sm_config *c, uint sideset_base)
+{
+  (void)c;
+  (void)sideset_base;
+}
+
+static inline void sm_config_set_out_shift(pio_sm_config *c, bool shift_right, bool autopull, uint pull_threshold)
+{
+  (void)shift_right;
+  (void)autopull;
+  c->bits_por_palavra = (uint8_t)pull_threshold;
+}
+
+static inline void sm_config_set_fifo_join(pio_sm_config *c, enum pio_fifo_join join)
+{
+  (void)c;
+  (void)join;
+}
+
+static inline void sm_config_set_clkdiv(pio_sm_config *c, float div) { c->clkdiv = div; }
+
+static inline uint pio_get_dreq(PIO pio, uint sm, bool is_tx) { return (pio == pio0 ? 0 : 8) + sm + (is_tx ? 0 : 4); }
+
+uint pio_add_program(PIO pio, const struct pio_program *program);
+void pio_gpio_init(PIO pio, uint pin);
+int pio_sm_set_consecutive_pindirs(PIO pio, uint sm, uint pin_base, uint pin_count, bool is_out);
+int pio_sm_init(PIO pio, uint sm, uint initial_pc, const pio_sm_config *config);
+void pio_sm_set_enabled(PIO pio, uint sm, bool enabled);
+void pio_sm_put_blocking(PIO pio, uint sm, uint32_t data);
+
+#endif // SIM_HARDWARE_PIO_H
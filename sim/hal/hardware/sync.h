@@ -0,0 +1,20 @@
+#ifndef SIM_HARDWARE_SYNC_H
+#define SIM_HARDWARE_SYNC_H
+
+// Substituto de hardware/sync.h. Na simulação os callbacks de interrupção só rodam entre
+// as fatias dos núcleos, então desligar interrupções não precisa fazer nada.
+
+#include "pico/types.h"
+
+uint32_t save_and_disable_interrupts(void);
+void restore_interrupts(uint32_t status);
+
+static inline void __dmb(void) { __atomic_thread_fence(__ATOMIC_SEQ_CST); }
+static inline void __mem_fence_acquire(void) { __atomic_thread_fence(__ATOMIC_ACQUIRE); }
+static inline void __mem_fence_release(void) { __atomic_thread_fence(__ATOMIC_RELEASE); }
+
+void __sev(void);
+void __wfe(void);
+void __wfi(void);
+
+#endif // SIM_HARDWARE_SYNC_H
@@ -0,0 +1,10 @@
+#ifndef SIM_PICO_BOOTROM_H
+#define SIM_PICO_BOOTROM_H
+
+// Substituto de pico/bootrom.h: entrar no bootloader encerra a simulação
+
+#include "pico/types.h"
+
+void reset_usb_boot(uint32_t usb_activity_gpio_pin_mask, uint32_t disable_interface_mask);
+
+#endif // SIM_PICO_BOOTROM_H
@@ -0,0 +1,14 @@
+#ifndef SIM_PICO_FLASH_H
+#define SIM_PICO_FLASH_H
+
+// Substituto de pico/flash.h: na simulação a flash do registro de auditoria é um arquivo
+// (sim_flash.c) e não há XIP a proteger, então nenhum núcleo precisa ser pausado
+
+#include "pico/types.h"
+
+static inline bool flash_safe_execute_core_init(void)
+{
+  return true;
+}
+
+#endif // SIM_PICO_FLASH_H
@@ -0,0 +1,10 @@
+#ifndef SIM_PICO_MULTICORE_H
+#define SIM_PICO_MULTICORE_H
+
+// Substituto de pico/multicore.h: o núcleo 1 é uma corrotina do agendador da simulação
+
+#include "pico/types.h"
+
+void multicore_launch_core1(void (*entry)(void));
+
+#endif // SIM_PICO_MULTICORE_H
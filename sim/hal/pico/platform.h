@@ -0,0 +1,10 @@
+#ifndef SIM_PICO_PLATFORM_H
+#define SIM_PICO_PLATFORM_H
+
+// Substituto de pico/platform.h: o núcleo atual é o que o agendador está executando
+
+#include "pico/types.h"
+
+uint get_core_num(void);
+
+#endif // SIM_PICO_PLATFORM_H
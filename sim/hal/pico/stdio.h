@@ -0,0 +1,12 @@
+#ifndef SIM_PICO_STDIO_H
+#define SIM_PICO_STDIO_H
+
+// Substituto de pico/stdio.h: a saída padrão do firmware vai para a do processo
+
+#include <stdio.h>
+#include "pico/types.h"
+
+bool stdio_init_all(void);
+int getchar_timeout_us(uint32_t timeout_us);
+
+#endif // SIM_PICO_STDIO_H
@@ -0,0 +1,12 @@
+#ifndef SIM_PICO_STDLIB_H
+#define SIM_PICO_STDLIB_H
+
+// Substituto de pico/stdlib.h para a simulação no computador
+
+#include "pico/types.h"
+#include "pico/platform.h"
+#include "pico/time.h"
+#include "pico/stdio.h"
+#include "hardware/gpio.h"
+
+#endif // SIM_PICO_STDLIB_H
@@ -0,0 +1,19 @@
+#ifndef SIM_PICO_TYPES_H
+#define SIM_PICO_TYPES_H
+
+// Substituto de pico/types.h para a simulação no computador
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef unsigned int uint;
+typedef uint64_t absolute_time_t; // Microssegundos do relógio virtual desde o boot
+
+#define PICO_OK 0
+#define PICO_ERROR_TIMEOUT (-1)
+#define PICO_ERROR_GENERIC (-2)
+
+static inline void tight_loop_contents(void) {}
+
+#endif // SIM_PICO_TYPES_H
@@ -0,0 +1,117 @@
+#include "sim.h"
+#include "roteiro.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Simulação do controle de acesso no computador. Executa o firmware sobre o relógio
+// virtual, aplica o roteiro de entradas e imprime um relatório JSON com o uso dos
+// barramentos, para comparar o desempenho entre versões sem depender da placa.
+//
+// Uso: controle_de_acesso_sim [-d duracao_ms] [-f flash.bin] [-o relatorio.json] [-t] [roteiro]
+//   -d  duração máxima simulada (padrão: 60000 ms)
+//   -f  guarda a flash do registro de auditoria num arquivo, mantido entre execuções
+//   -o  grava o relatório em um arquivo em vez da saída padrão
+//   -t  imprime o display na saída de erro ao final
+
+#define DURACAO_PADRAO_MS 60000
+
+int firmware_main(); // main() de controle_de_acesso.c, renomeada na compilação
+
+static void nucleo0(void)
+{
+  firmware_main();
+  sim_parar("main retornou");
+}
+
+static void imprimir_relatorio(FILE *saida)
+{
+  const sim_contadores_t *c = &sim_contadores;
+  const char *motivo = sim_motivo_parada();
+
+  fprintf(saida, "{\n");
+  fprintf(saida, "  \"tempo_simulado_us\": %llu,\n", (unsigned long long)sim_agora_us());
+  fprintf(saida, "  \"motivo_parada\": \"%s\",\n", motivo ? motivo : "fim");
+  fprintf(saida, "  \"i2c\": {\"transacoes\": %llu, \"bytes\": %llu, \"tempo_barramento_us\": %llu},\n",
+          (unsigned long long)c->i2c_transacoes, (unsigned long long)c->i2c_bytes,
+          (unsigned long long)(c->i2c_tempo_ns / 1000));
+  fprintf(saida, "  \"oled\": {\"bytes_comando\": %llu, \"bytes_dados\": %llu},\n",
+          (unsigned long long)c->oled_bytes_comando, (unsigned long long)c->oled_bytes_dados);
+  fprintf(saida, "  \"pio\": {\"palavras\": %llu, \"tempo_us\": %llu},\n", (unsigned long long)c->pio_palavras,
+          (unsigned long long)(c->pio_tempo_ns / 1000));
+  fprintf(saida, "  \"dma\": {\"disparos\": %llu},\n", (unsigned long long)c->dma_disparos);
+  fprintf(saida, "  \"adc\": {\"amostras\": %llu},\n", (unsigned long long)c->adc_amostras);
+  fprintf(saida, "  \"gpio\": {\"escritas\": %llu, \"interrupcoes\": %llu},\n",
+          (unsigned long long)c->gpio_escritas, (unsigned long long)c->gpio_interrupcoes);
+  fprintf(saida, "  \"pwm\": {\"alteracoes\": %llu},\n", (unsigned long long)c->pwm_alteracoes);
+  fprintf(saida, "  \"flash\": {\"gravacoes\": %llu, \"apagamentos\": %llu},\n",
+          (unsigned long long)c->flash_gravacoes, (unsigned long long)c->flash_apagamentos);
+  fprintf(saida, "  \"alarmes\": {\"disparos\": %llu},\n", (unsigned long long)c->alarmes_disparados);
+  fprintf(saida, "  \"nucleos\": {\"trocas_contexto\": %llu}\n", (unsigned long long)c->trocas_contexto);
+  fprintf(saida, "}\n");
+}
+
+int main(int argc, char **argv)
+{
+  uint64_t duracao_ms = DURACAO_PADRAO_MS;
+  const char *arquivo_relatorio = NULL;
+  const char *arquivo_roteiro = NULL;
+  bool imprimir_tela = false;
+
+  for (int i = 1; i < argc; i++)
+  {
+    if (strcmp(argv[i], "-d") == 0 && i + 1 < argc)
+      duracao_ms = strtoull(argv[++i], NULL, 10);
+    else if (strcmp(argv[i], "-f") == 0 && i + 1 < argc)
+    {
+      if (!sim_flash_arquivo(argv[++i]))
+        return 1;
+    }
+    else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+      arquivo_relatorio = argv[++i];
+    else if (strcmp(argv[i], "-t") == 0)
+      imprimir_tela = true;
+    else if (argv[i][0] != '-' && !arquivo_roteiro)
+      arquivo_roteiro = argv[i];
+    else
+    {
+      fprintf(stderr, "uso: %s [-d duracao_ms] [-f flash.bin] [-o relatorio.json] [-t] [roteiro]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  if (arquivo_roteiro && !roteiro_carregar(arquivo_roteiro))
+    return 2;
+
+  // Painel externo no i2c1 e interno no i2c0, ambos no endereço padrão
+  sim_oled_conectar(1, SIM_OLED_ENDERECO);
+  sim_oled_conectar(0, SIM_OLED_ENDERECO);
+
+  sim_iniciar_nucleo(0, nucleo0);
+
+  // Roda até cada evento do roteiro, aplica o evento e segue até a duração máxima
+  uint64_t fim_us = duracao_ms * 1000;
+  while (true)
+  {
+    uint64_t alvo_us = roteiro_proximo_us();
+    if (alvo_us > fim_us)
+      alvo_us = fim_us;
+    if (!sim_executar_ate(alvo_us) || alvo_us == fim_us)
+      break;
+    if (!roteiro_aplicar(alvo_us, stderr))
+      break;
+  }
+
+  if (imprimir_tela)
+    sim_oled_imprimir(stderr);
+
+  FILE *saida = stdout;
+  if (arquivo_relatorio && !(saida = fopen(arquivo_relatorio, "w")))
+  {
+    perror(arquivo_relatorio);
+    return 1;
+  }
+  imprimir_relatorio(saida);
+  if (saida != stdout)
+    fclose(saida);
+  return 0;
+}
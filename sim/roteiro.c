@@ -0,0 +1,131 @@
+#include "roteiro.h"
+#include "sim.h"
+#include <stdlib.h>
+#include <string.h>
+
+typedef enum
+{
+  ACAO_GPIO,
+  ACAO_ADC,
+  ACAO_SERIAL,
+  ACAO_TELA,
+  ACAO_FIM
+} roteiro_acao_t;
+
+typedef struct
+{
+  uint64_t instante_us;
+  roteiro_acao_t acao;
+  uint alvo;      // Pino ou canal
+  uint32_t valor; // Nível, valor do ADC ou caractere da serial
+} roteiro_evento_t;
+
+static roteiro_evento_t *eventos;
+static size_t quantidade, capacidade, proximo;
+
+// Insere mantendo a ordem de tempo; eventos no mesmo instante ficam na ordem do arquivo
+static void inserir(uint64_t instante_us, roteiro_acao_t acao, uint alvo, uint32_t valor)
+{
+  if (quantidade == capacidade)
+  {
+    capacidade = capacidade ? capacidade * 2 : 32;
+    eventos = realloc(eventos, capacidade * sizeof(eventos[0]));
+  }
+  size_t i = quantidade++;
+  while (i > 0 && eventos[i - 1].instante_us > instante_us)
+  {
+    eventos[i] = eventos[i - 1];
+    i--;
+  }
+  eventos[i] = (roteiro_evento_t){instante_us, acao, alvo, valor};
+}
+
+bool roteiro_carregar(const char *caminho)
+{
+  FILE *arquivo = fopen(caminho, "r");
+  if (!arquivo)
+  {
+    perror(caminho);
+    return false;
+  }
+
+  char linha[256];
+  unsigned numero = 0;
+  bool ok = true;
+  while (fgets(linha, sizeof(linha), arquivo))
+  {
+    numero++;
+    char *comentario = strchr(linha, '#');
+    if (comentario)
+      *comentario = '\0';
+
+    unsigned long ms;
+    char acao[16];
+    unsigned alvo, valor;
+    char texto[64];
+    int campos = sscanf(linha, "%lu %15s %u %u", &ms, acao, &alvo, &valor);
+    if (campos <= 0)
+      continue; // Linha vazia
+
+    uint64_t instante_us = (uint64_t)ms * 1000;
+    if (campos == 4 && strcmp(acao, "gpio") == 0 && alvo < SIM_NUM_GPIO)
+      inserir(instante_us, ACAO_GPIO, alvo, valor != 0);
+    else if (campos == 4 && strcmp(acao, "botao") == 0 && alvo < SIM_NUM_GPIO)
+    {
+      inserir(instante_us, ACAO_GPIO, alvo, 0);
+      inserir(instante_us + (uint64_t)valor * 1000, ACAO_GPIO, alvo, 1);
+    }
+    else if (campos == 4 && strcmp(acao, "adc") == 0 && alvo < SIM_NUM_ADC && valor < 4096)
+      inserir(instante_us, ACAO_ADC, alvo, valor);
+    else if (campos == 2 && strcmp(acao, "serial") == 0 && sscanf(linha, "%*u %*s %63s", texto) == 1)
+    {
+      for (const char *c = texto; *c; c++)
+        inserir(instante_us, ACAO_SERIAL, 0, (unsigned char)*c);
+    }
+    else if (campos == 2 && strcmp(acao, "tela") == 0)
+      inserir(instante_us, ACAO_TELA, 0, 0);
+    else if (campos == 2 && strcmp(acao, "fim") == 0)
+      inserir(instante_us, ACAO_FIM, 0, 0);
+    else
+    {
+      fprintf(stderr, "%s:%u: ação inválida\n", caminho, numero);
+      ok = false;
+    }
+  }
+  fclose(arquivo);
+  return ok;
+}
+
+// Instante do próximo evento ainda não aplicado
+uint64_t roteiro_proximo_us(void)
+{
+  return proximo < quantidade ? eventos[proximo].instante_us : SIM_NUNCA;
+}
+
+// Aplica os eventos vencidos; retorna false ao encontrar 'fim'
+bool roteiro_aplicar(uint64_t agora_us, FILE *saida_tela)
+{
+  while (proximo < quantidade && eventos[proximo].instante_us <= agora_us)
+  {
+    const roteiro_evento_t *evento = &eventos[proximo++];
+    switch (evento->acao)
+    {
+    case ACAO_GPIO:
+      sim_gpio_entrada(evento->alvo, evento->valor);
+      break;
+    case ACAO_ADC:
+      sim_adc_definir(evento->alvo, (uint16_t)evento->valor);
+      break;
+    case ACAO_SERIAL:
+      sim_serial_entrada((char)evento->valor);
+      break;
+    case ACAO_TELA:
+      fprintf(saida_tela, "t = %llu ms\n", (unsigned long long)(agora_us / 1000));
+      sim_oled_imprimir(saida_tela);
+      break;
+    case ACAO_FIM:
+      return false;
+    }
+  }
+  return true;
+}
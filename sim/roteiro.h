@@ -0,0 +1,22 @@
+#ifndef ROTEIRO_H
+#define ROTEIRO_H
+
+// Roteiro de entradas da simulação: uma ação por linha, em ordem de tempo.
+//
+//   <ms> gpio <pino> <0|1>         nível imposto a um pino de entrada
+//   <ms> botao <pino> <duracao_ms> pressiona (nível 0) e solta depois da duração
+//   <ms> adc <canal> <valor>       valor (0-4095) lido por um canal do ADC
+//   <ms> serial <texto>            caracteres recebidos pela serial/USB
+//   <ms> tela                      imprime o display na saída de erro
+//   <ms> fim                       encerra a simulação
+//
+// '#' inicia um comentário.
+
+#include <stdio.h>
+#include "pico/types.h"
+
+bool roteiro_carregar(const char *caminho);
+uint64_t roteiro_proximo_us(void);
+bool roteiro_aplicar(uint64_t agora_us, FILE *saida_tela);
+
+#endif // ROTEIRO_H
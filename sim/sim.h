@@ -0,0 +1,62 @@
+#ifndef SIM_H
+#define SIM_H
+
+// Núcleo da simulação no computador: relógio virtual, agendador dos dois núcleos,
+// periféricos controlados pelo roteiro e contabilização de barramentos.
+
+#include <stdio.h>
+#include "pico/types.h"
+
+#define SIM_NUNCA UINT64_MAX
+#define SIM_NUM_GPIO 30
+#define SIM_NUM_ADC 5
+#define SIM_OLED_ENDERECO 0x3C
+
+// Contadores acumulados desde o início da simulação
+typedef struct
+{
+  uint64_t i2c_transacoes;
+  uint64_t i2c_bytes;        // Inclui o byte de endereço de cada transação
+  uint64_t i2c_tempo_ns;     // Tempo de barramento ocupado
+  uint64_t oled_bytes_comando;
+  uint64_t oled_bytes_dados;
+  uint64_t pio_palavras;
+  uint64_t pio_tempo_ns;     // Tempo que as máquinas de estados levam para deslocar as palavras
+  uint64_t dma_disparos;
+  uint64_t adc_amostras;
+  uint64_t gpio_escritas;
+  uint64_t gpio_interrupcoes;
+  uint64_t pwm_alteracoes;
+  uint64_t alarmes_disparados;
+  uint64_t flash_gravacoes;    // Páginas gravadas na região do registro de auditoria
+  uint64_t flash_apagamentos;  // Setores apagados
+  uint64_t trocas_contexto;
+} sim_contadores_t;
+
+extern sim_contadores_t sim_contadores;
+
+// Relógio virtual e núcleos (sim_nucleos.c)
+uint64_t sim_agora_us(void);
+void sim_ceder_ate(uint64_t instante_us);
+void sim_sinalizar_interrupcao(void);
+void sim_iniciar_nucleo(uint nucleo, void (*entrada)(void));
+bool sim_executar_ate(uint64_t fim_us);
+void sim_parar(const char *motivo);
+const char *sim_motivo_parada(void);
+
+// Periféricos (sim_perifericos.c)
+void sim_perifericos_avancar(uint64_t ate_us);
+void sim_gpio_entrada(uint pino, bool nivel);
+bool sim_gpio_saida(uint pino);
+void sim_adc_definir(uint canal, uint16_t valor);
+void sim_serial_entrada(char caractere);
+
+// Flash do registro de auditoria (sim_flash.c)
+bool sim_flash_arquivo(const char *caminho);
+
+// Display SSD1306 (sim_oled.c)
+bool sim_oled_conectar(uint barramento, uint8_t endereco);
+bool sim_oled_transacao(uint barramento, uint8_t endereco, const uint8_t *bytes, size_t quantidade);
+void sim_oled_imprimir(FILE *saida);
+
+#endif // SIM_H
@@ -0,0 +1,77 @@
+#include "sim.h"
+#include <string.h>
+#include "lib/auditoria.h"
+
+// Substitui lib/auditoria_flash.c: a região do registro de auditoria fica na memória e,
+// com a opção -f, num arquivo que sobrevive entre execuções, como a flash entre
+// reinicializações. Gravar só leva bits de 1 para 0 e apagar volta o setor a 0xFF,
+// como na flash de verdade.
+
+#define SIM_FLASH_TAMANHO (AUDITORIA_FLASH_SETORES * AUDITORIA_SETOR)
+
+static uint8_t flash[SIM_FLASH_TAMANHO];
+static FILE *arquivo = NULL;
+
+// Carrega a imagem da flash de um arquivo, criado em branco se não existir
+bool sim_flash_arquivo(const char *caminho)
+{
+  memset(flash, 0xFF, sizeof(flash));
+  arquivo = fopen(caminho, "r+b");
+  if (arquivo)
+  {
+    size_t lidos = fread(flash, 1, sizeof(flash), arquivo);
+    (void)lidos; // Um arquivo menor é completado com 0xFF
+  }
+  else if (!(arquivo = fopen(caminho, "w+b")))
+  {
+    perror(caminho);
+    return false;
+  }
+  fseek(arquivo, 0, SEEK_SET);
+  fwrite(flash, 1, sizeof(flash), arquivo);
+  fflush(arquivo);
+  return true;
+}
+
+static void persistir(uint32_t deslocamento, size_t tamanho)
+{
+  if (!arquivo)
+    return;
+  fseek(arquivo, (long)deslocamento, SEEK_SET);
+  fwrite(&flash[deslocamento], 1, tamanho, arquivo);
+  fflush(arquivo);
+}
+
+static void ler(void *contexto, uint32_t deslocamento, void *destino, size_t tamanho)
+{
+  (void)contexto;
+  memcpy(destino, &flash[deslocamento], tamanho);
+}
+
+static bool apagar(void *contexto, uint32_t deslocamento)
+{
+  (void)contexto;
+  memset(&flash[deslocamento], 0xFF, AUDITORIA_SETOR);
+  persistir(deslocamento, AUDITORIA_SETOR);
+  sim_contadores.flash_apagamentos++;
+  return true;
+}
+
+static bool programar(void *contexto, uint32_t deslocamento, const uint8_t *pagina)
+{
+  (void)contexto;
+  for (size_t i = 0; i < AUDITORIA_PAGINA; i++)
+    flash[deslocamento + i] &= pagina[i];
+  persistir(deslocamento, AUDITORIA_PAGINA);
+  sim_contadores.flash_gravacoes++;
+  return true;
+}
+
+void auditoria_meio_flash(auditoria_meio_t *meio)
+{
+  meio->tamanho = SIM_FLASH_TAMANHO;
+  meio->ler = ler;
+  meio->apagar = apagar;
+  meio->programar = programar;
+  meio->contexto = NULL;
+}
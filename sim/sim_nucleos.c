@@ -0,0 +1,463 @@
+#include "sim.h"
+#include <stdlib.h>
+#include <ucontext.h>
+#include "pico/time.h"
+#include "pico/multicore.h"
+#include "pico/platform.h"
+#include "hardware/sync.h"
+
+#define SIM_NUCLEOS 2
+#define SIM_PILHA_BYTES (256 * 1024)
+#define SIM_ALARMES_MAX 64
+
+// Cada núcleo do RP2040 é uma corrotina. Um núcleo roda sem consumir tempo virtual até
+// esperar (sleep, __wfe, periférico ocupado) e então devolve o controle ao agendador,
+// que avança o relógio até o próximo acontecimento. Com isso cada execução é determinística.
+typedef enum
+{
+  ESPERA_NENHUMA,
+  ESPERA_EVENTO,      // __wfe(): acorda com __sev() ou interrupção
+  ESPERA_INTERRUPCAO  // __wfi(): acorda só com interrupção
+} sim_espera_t;
+
+typedef struct
+{
+  ucontext_t contexto;
+  void (*entrada)(void);
+  bool ativo;
+  sim_espera_t espera;
+  bool evento;         // Registrador de evento do ARM
+  uint64_t acordar_us; // Instante em que o núcleo volta a rodar (se não estiver em espera)
+  uint64_t prazo_us;   // Em espera: instante em que ela termina mesmo sem evento
+} sim_nucleo_t;
+
+typedef struct
+{
+  alarm_id_t id; // 0 = posição livre
+  uint64_t instante_us;
+  alarm_callback_t callback;
+  void *user_data;
+  repeating_timer_t *repetidor; // Não nulo para temporizadores repetitivos
+} sim_alarme_t;
+
+struct alarm_pool
+{
+  uint max_timers;
+};
+
+sim_contadores_t sim_contadores;
+
+static sim_nucleo_t nucleos[SIM_NUCLEOS];
+static int nucleo_atual = -1; // -1 = agendador ou callback de interrupção
+static ucontext_t contexto_agendador;
+static uint64_t agora_us = 0;
+static const char *motivo_parada = NULL;
+
+static sim_alarme_t alarmes[SIM_ALARMES_MAX];
+static alarm_id_t proximo_id = 1;
+static alarm_pool_t pool_padrao = {SIM_ALARMES_MAX};
+static alarm_pool_t pool_extra = {SIM_ALARMES_MAX};
+
+// Devolve o controle ao agendador
+static void ceder(sim_nucleo_t *nucleo)
+{
+  sim_contadores.trocas_contexto++;
+  swapcontext(&nucleo->contexto, &contexto_agendador);
+}
+
+static void acordar(sim_nucleo_t *nucleo)
+{
+  if (nucleo->espera != ESPERA_NENHUMA)
+  {
+    nucleo->espera = ESPERA_NENHUMA;
+    nucleo->acordar_us = agora_us;
+  }
+}
+
+// Ponto de partida das corrotinas: quando a função do núcleo retorna, o núcleo para
+static void trampolim(int indice)
+{
+  sim_nucleo_t *nucleo = &nucleos[indice];
+  nucleo->entrada();
+  nucleo->ativo = false;
+  ceder(nucleo);
+}
+
+uint64_t sim_agora_us(void)
+{
+  return agora_us;
+}
+
+// O núcleo atual fica parado até o instante indicado. Dentro de um callback de
+// interrupção não há como esperar, e a chamada retorna na hora.
+void sim_ceder_ate(uint64_t instante_us)
+{
+  if (nucleo_atual < 0)
+    return;
+  sim_nucleo_t *nucleo = &nucleos[nucleo_atual];
+  nucleo->acordar_us = instante_us > agora_us ? instante_us : agora_us;
+  ceder(nucleo);
+}
+
+// Uma interrupção aconteceu: acorda os núcleos parados em __wfe()/__wfi()
+void sim_sinalizar_interrupcao(void)
+{
+  for (int i = 0; i < SIM_NUCLEOS; i++)
+  {
+    nucleos[i].evento = true;
+    acordar(&nucleos[i]);
+  }
+}
+
+void sim_iniciar_nucleo(uint indice, void (*entrada)(void))
+{
+  sim_nucleo_t *nucleo = &nucleos[indice];
+  getcontext(&nucleo->contexto);
+  nucleo->contexto.uc_stack.ss_sp = malloc(SIM_PILHA_BYTES);
+  nucleo->contexto.uc_stack.ss_size = SIM_PILHA_BYTES;
+  nucleo->contexto.uc_link = NULL;
+  makecontext(&nucleo->contexto, (void (*)(void))trampolim, 1, (int)indice);
+  nucleo->entrada = entrada;
+  nucleo->ativo = true;
+  nucleo->espera = ESPERA_NENHUMA;
+  nucleo->evento = false;
+  nucleo->acordar_us = agora_us;
+  nucleo->prazo_us = SIM_NUNCA;
+}
+
+// Encerra a simulação; chamada por um núcleo, ele não volta a rodar
+void sim_parar(const char *motivo)
+{
+  if (!motivo_parada)
+    motivo_parada = motivo;
+  if (nucleo_atual >= 0)
+  {
+    sim_nucleo_t *nucleo = &nucleos[nucleo_atual];
+    nucleo->ativo = false;
+    ceder(nucleo);
+  }
+}
+
+const char *sim_motivo_parada(void)
+{
+  return motivo_parada;
+}
+
+// Roda, em ordem, cada núcleo pronto até ele esperar de novo
+static bool executar_prontos(void)
+{
+  bool executou = false;
+  for (int i = 0; i < SIM_NUCLEOS && !motivo_parada; i++)
+  {
+    sim_nucleo_t *nucleo = &nucleos[i];
+    if (nucleo->espera != ESPERA_NENHUMA && nucleo->prazo_us <= agora_us)
+      acordar(nucleo);
+    if (nucleo->ativo && nucleo->espera == ESPERA_NENHUMA && nucleo->acordar_us <= agora_us)
+    {
+      nucleo_atual = i;
+      swapcontext(&contexto_agendador, &nucleo->contexto);
+      nucleo_atual = -1;
+      executou = true;
+    }
+  }
+  return executou;
+}
+
+// Próximo instante em que algo acontece: um núcleo acorda ou um alarme dispara
+static uint64_t proximo_instante(void)
+{
+  uint64_t proximo = SIM_NUNCA;
+  for (int i = 0; i < SIM_NUCLEOS; i++)
+  {
+    if (nucleos[i].ativo && nucleos[i].espera == ESPERA_NENHUMA && nucleos[i].acordar_us < proximo)
+      proximo = nucleos[i].acordar_us;
+    if (nucleos[i].ativo && nucleos[i].espera != ESPERA_NENHUMA && nucleos[i].prazo_us < proximo)
+      proximo = nucleos[i].prazo_us;
+  }
+  for (int i = 0; i < SIM_ALARMES_MAX; i++)
+  {
+    if (alarmes[i].id && alarmes[i].instante_us < proximo)
+      proximo = alarmes[i].instante_us;
+  }
+  return proximo;
+}
+
+// Alarme vencido mais antigo (empate: o de menor id), ou NULL
+static sim_alarme_t *alarme_vencido(void)
+{
+  sim_alarme_t *escolhido = NULL;
+  for (int i = 0; i < SIM_ALARMES_MAX; i++)
+  {
+    sim_alarme_t *alarme = &alarmes[i];
+    if (!alarme->id || alarme->instante_us > agora_us)
+      continue;
+    if (!escolhido || alarme->instante_us < escolhido->instante_us ||
+        (alarme->instante_us == escolhido->instante_us && alarme->id < escolhido->id))
+      escolhido = alarme;
+  }
+  return escolhido;
+}
+
+// Executa os callbacks de todos os alarmes vencidos, reagendando como o SDK faria
+static void disparar_alarmes(void)
+{
+  sim_alarme_t *alarme;
+  while ((alarme = alarme_vencido()) != NULL)
+  {
+    sim_contadores.alarmes_disparados++;
+    uint64_t previsto_us = alarme->instante_us;
+
+    if (alarme->repetidor)
+    {
+      repeating_timer_t *repetidor = alarme->repetidor;
+      if (repetidor->callback(repetidor) && alarme->id == repetidor->alarm_id)
+      {
+        // Período negativo: contado a partir do disparo anterior; positivo: a partir do fim do callback
+        alarme->instante_us = repetidor->delay_us < 0 ? previsto_us - repetidor->delay_us
+                                                      : agora_us + repetidor->delay_us;
+      }
+      else
+        alarme->id = 0;
+    }
+    else
+    {
+      alarm_id_t id = alarme->id;
+      int64_t reagendar = alarme->callback(id, alarme->user_data);
+      if (alarme->id != id)
+        ; // Cancelado dentro do callback
+      else if (reagendar > 0)
+        alarme->instante_us = previsto_us + reagendar;
+      else if (reagendar < 0)
+        alarme->instante_us = agora_us - reagendar;
+      else
+        alarme->id = 0;
+    }
+    sim_sinalizar_interrupcao();
+  }
+}
+
+// Avança a simulação até 'fim_us'; retorna false se ela foi encerrada antes
+bool sim_executar_ate(uint64_t fim_us)
+{
+  while (!motivo_parada)
+  {
+    while (executar_prontos())
+      ;
+    if (motivo_parada)
+      break;
+
+    uint64_t proximo = proximo_instante();
+    if (proximo > fim_us)
+    {
+      agora_us = fim_us > agora_us ? fim_us : agora_us;
+      sim_perifericos_avancar(agora_us);
+      return true;
+    }
+    if (proximo > agora_us)
+    {
+      agora_us = proximo;
+      sim_perifericos_avancar(agora_us);
+    }
+    disparar_alarmes();
+  }
+  return false;
+}
+
+// ---------------------------------------------------------------------------------------
+// pico/time.h
+
+uint64_t time_us_64(void)
+{
+  return agora_us;
+}
+
+void sleep_until(absolute_time_t target)
+{
+  sim_ceder_ate(target);
+}
+
+void sleep_us(uint64_t us)
+{
+  sim_ceder_ate(agora_us + us);
+}
+
+void sleep_ms(uint32_t ms)
+{
+  sim_ceder_ate(agora_us + (uint64_t)ms * 1000);
+}
+
+// __wfe() que também acorda no instante indicado. Retorna true se o prazo foi atingido.
+bool best_effort_wfe_or_timeout(absolute_time_t timeout_timestamp)
+{
+  if (nucleo_atual < 0 || agora_us >= timeout_timestamp)
+    return true;
+  sim_nucleo_t *nucleo = &nucleos[nucleo_atual];
+  if (!nucleo->evento)
+  {
+    nucleo->espera = ESPERA_EVENTO;
+    nucleo->prazo_us = timeout_timestamp;
+    ceder(nucleo);
+    nucleo->prazo_us = SIM_NUNCA;
+  }
+  nucleo->evento = false;
+  return agora_us >= timeout_timestamp;
+}
+
+static sim_alarme_t *novo_alarme(uint64_t instante_us)
+{
+  for (int i = 0; i < SIM_ALARMES_MAX; i++)
+  {
+    if (!alarmes[i].id)
+    {
+      sim_alarme_t *alarme = &alarmes[i];
+      alarme->id = proximo_id++;
+      alarme->instante_us = instante_us;
+      alarme->repetidor = NULL;
+      return alarme;
+    }
+  }
+  return NULL;
+}
+
+alarm_pool_t *alarm_pool_get_default(void)
+{
+  return &pool_padrao;
+}
+
+// Todos os pools compartilham a mesma tabela: na simulação não há núcleo dono de um alarme
+alarm_pool_t *alarm_pool_create_with_unused_hardware_alarm(uint max_timers)
+{
+  pool_extra.max_timers = max_timers;
+  return &pool_extra;
+}
+
+alarm_id_t alarm_pool_add_alarm_in_us(alarm_pool_t *pool, uint64_t us, alarm_callback_t callback, void *user_data,
+                                      bool fire_if_past)
+{
+  (void)pool;
+  (void)fire_if_past;
+  sim_alarme_t *alarme = novo_alarme(agora_us + us);
+  if (!alarme)
+    return -1;
+  alarme->callback = callback;
+  alarme->user_data = user_data;
+  return alarme->id;
+}
+
+bool alarm_pool_cancel_alarm(alarm_pool_t *pool, alarm_id_t alarm_id)
+{
+  (void)pool;
+  for (int i = 0; i < SIM_ALARMES_MAX; i++)
+  {
+    if (alarm_id > 0 && alarmes[i].id == alarm_id)
+    {
+      alarmes[i].id = 0;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool alarm_pool_add_repeating_timer_us(alarm_pool_t *pool, int64_t delay_us, repeating_timer_callback_t callback,
+                                       void *user_data, repeating_timer_t *out)
+{
+  (void)pool;
+  sim_alarme_t *alarme = novo_alarme(agora_us + (uint64_t)(delay_us < 0 ? -delay_us : delay_us));
+  if (!alarme)
+    return false;
+  out->delay_us = delay_us;
+  out->callback = callback;
+  out->user_data = user_data;
+  out->alarm_id = alarme->id;
+  alarme->repetidor = out;
+  return true;
+}
+
+alarm_id_t add_alarm_in_us(uint64_t us, alarm_callback_t callback, void *user_data, bool fire_if_past)
+{
+  return alarm_pool_add_alarm_in_us(&pool_padrao, us, callback, user_data, fire_if_past);
+}
+
+alarm_id_t add_alarm_in_ms(uint32_t ms, alarm_callback_t callback, void *user_data, bool fire_if_past)
+{
+  return alarm_pool_add_alarm_in_us(&pool_padrao, (uint64_t)ms * 1000, callback, user_data, fire_if_past);
+}
+
+bool cancel_alarm(alarm_id_t alarm_id)
+{
+  return alarm_pool_cancel_alarm(&pool_padrao, alarm_id);
+}
+
+bool add_repeating_timer_us(int64_t delay_us, repeating_timer_callback_t callback, void *user_data,
+                            repeating_timer_t *out)
+{
+  return alarm_pool_add_repeating_timer_us(&pool_padrao, delay_us, callback, user_data, out);
+}
+
+bool add_repeating_timer_ms(int32_t delay_ms, repeating_timer_callback_t callback, void *user_data,
+                            repeating_timer_t *out)
+{
+  return alarm_pool_add_repeating_timer_us(&pool_padrao, (int64_t)delay_ms * 1000, callback, user_data, out);
+}
+
+bool cancel_repeating_timer(repeating_timer_t *timer)
+{
+  return alarm_pool_cancel_alarm(&pool_padrao, timer->alarm_id);
+}
+
+// ---------------------------------------------------------------------------------------
+// hardware/sync.h e pico/multicore.h
+
+// Callbacks nunca interrompem um núcleo no meio do código, então não há o que desligar
+uint32_t save_and_disable_interrupts(void)
+{
+  return 0;
+}
+
+void restore_interrupts(uint32_t status)
+{
+  (void)status;
+}
+
+void __sev(void)
+{
+  for (int i = 0; i < SIM_NUCLEOS; i++)
+  {
+    nucleos[i].evento = true;
+    if (nucleos[i].espera == ESPERA_EVENTO)
+      acordar(&nucleos[i]);
+  }
+}
+
+void __wfe(void)
+{
+  if (nucleo_atual < 0)
+    return;
+  sim_nucleo_t *nucleo = &nucleos[nucleo_atual];
+  if (!nucleo->evento)
+  {
+    nucleo->espera = ESPERA_EVENTO;
+    ceder(nucleo);
+  }
+  nucleo->evento = false;
+}
+
+void __wfi(void)
+{
+  if (nucleo_atual < 0)
+    return;
+  sim_nucleo_t *nucleo = &nucleos[nucleo_atual];
+  nucleo->espera = ESPERA_INTERRUPCAO;
+  ceder(nucleo);
+}
+
+// Callbacks de interrupção são atribuídos ao núcleo 0
+uint get_core_num(void)
+{
+  return nucleo_atual > 0 ? (uint)nucleo_atual : 0;
+}
+
+void multicore_launch_core1(void (*entry)(void))
+{
+  sim_iniciar_nucleo(1, entry);
+}
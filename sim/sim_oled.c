@@ -0,0 +1,241 @@
+#include "sim.h"
+#include <string.h>
+
+// Controladores SSD1306 de 128x64 ligados ao I2C, cada um num barramento e endereço:
+// interpretam os bytes de controle, os comandos de endereçamento e gravam os dados na
+// GDDRAM, como o display real faria.
+
+#define OLED_LARGURA 128
+#define OLED_PAGINAS 8
+#define OLED_ALTURA (OLED_PAGINAS * 8)
+#define SIM_OLEDS 4
+
+typedef struct
+{
+  uint barramento;
+  uint8_t endereco;
+  bool usado; // Já recebeu alguma transação
+  uint8_t gddram[OLED_PAGINAS][OLED_LARGURA];
+  uint8_t modo; // 0 = horizontal, 1 = vertical, 2 = por página
+  uint8_t coluna_inicio, coluna_fim, pagina_inicio, pagina_fim;
+  uint8_t coluna, pagina;
+  bool ligado, invertido;
+  uint8_t contraste, linha_inicial;
+  uint8_t comando;     // Comando que aguarda argumentos
+  uint8_t argumentos[6];
+  uint8_t recebidos, esperados;
+} sim_oled_t;
+
+static sim_oled_t oleds[SIM_OLEDS];
+static uint total_oleds = 0;
+
+// Liga um painel ao barramento i2c0 ou i2c1 no endereço indicado
+bool sim_oled_conectar(uint barramento, uint8_t endereco)
+{
+  if (total_oleds == SIM_OLEDS)
+    return false;
+  sim_oled_t *oled = &oleds[total_oleds++];
+  memset(oled, 0, sizeof(*oled));
+  oled->barramento = barramento;
+  oled->endereco = endereco;
+  oled->modo = 2;
+  oled->coluna_fim = OLED_LARGURA - 1;
+  oled->pagina_fim = OLED_PAGINAS - 1;
+  oled->contraste = 0x7F;
+  return true;
+}
+
+// Quantidade de bytes de argumento de cada comando
+static uint8_t argumentos_do_comando(uint8_t comando)
+{
+  switch (comando)
+  {
+  case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3: case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+    return 1;
+  case 0x21: case 0x22: case 0xA3:
+    return 2;
+  case 0x29: case 0x2A:
+    return 5;
+  case 0x26: case 0x27:
+    return 6;
+  default:
+    return 0;
+  }
+}
+
+static void executar_comando(sim_oled_t *oled, uint8_t comando, const uint8_t *arg)
+{
+  if (comando >= 0x40 && comando <= 0x7F)
+    oled->linha_inicial = comando & 0x3F;
+  else if (comando >= 0xB0 && comando <= 0xB7)
+    oled->pagina = comando & 0x07;
+  else if (comando <= 0x0F)
+    oled->coluna = (oled->coluna & 0xF0) | comando;
+  else if (comando <= 0x1F)
+    oled->coluna = (oled->coluna & 0x0F) | ((comando & 0x0F) << 4);
+  else
+  {
+    switch (comando)
+    {
+    case 0x20:
+      oled->modo = arg[0] & 0x03;
+      break;
+    case 0x21:
+      oled->coluna_inicio = oled->coluna = arg[0] & 0x7F;
+      oled->coluna_fim = arg[1] & 0x7F;
+      break;
+    case 0x22:
+      oled->pagina_inicio = oled->pagina = arg[0] & 0x07;
+      oled->pagina_fim = arg[1] & 0x07;
+      break;
+    case 0x81:
+      oled->contraste = arg[0];
+      break;
+    case 0xA6:
+    case 0xA7:
+      oled->invertido = comando & 1;
+      break;
+    case 0xAE:
+    case 0xAF:
+      oled->ligado = comando & 1;
+      break;
+    default:
+      break;
+    }
+  }
+}
+
+static void receber_comando(sim_oled_t *oled, uint8_t byte)
+{
+  sim_contadores.oled_bytes_comando++;
+  if (oled->esperados)
+  {
+    oled->argumentos[oled->recebidos++] = byte;
+    if (oled->recebidos == oled->esperados)
+    {
+      oled->esperados = 0;
+      executar_comando(oled, oled->comando, oled->argumentos);
+    }
+    return;
+  }
+  oled->comando = byte;
+  oled->recebidos = 0;
+  oled->esperados = argumentos_do_comando(byte);
+  if (!oled->esperados)
+    executar_comando(oled, byte, NULL);
+}
+
+// Grava um byte na GDDRAM e avança o ponteiro conforme o modo de endereçamento
+static void receber_dado(sim_oled_t *oled, uint8_t byte)
+{
+  sim_contadores.oled_bytes_dados++;
+  oled->gddram[oled->pagina][oled->coluna] = byte;
+
+  if (oled->modo == 2)
+  {
+    oled->coluna = (oled->coluna + 1) % OLED_LARGURA;
+  }
+  else if (oled->modo == 1)
+  {
+    if (oled->pagina == oled->pagina_fim)
+    {
+      oled->pagina = oled->pagina_inicio;
+      oled->coluna = oled->coluna == oled->coluna_fim ? oled->coluna_inicio : oled->coluna + 1;
+    }
+    else
+      oled->pagina++;
+  }
+  else
+  {
+    if (oled->coluna == oled->coluna_fim)
+    {
+      oled->coluna = oled->coluna_inicio;
+      oled->pagina = oled->pagina == oled->pagina_fim ? oled->pagina_inicio : oled->pagina + 1;
+    }
+    else
+      oled->coluna++;
+  }
+}
+
+// Uma transação I2C (sem o byte de endereço): com Co = 1 cada byte vem precedido de um
+// byte de controle; com Co = 0 o resto da transação é de comandos ou de dados (D/C).
+// Retorna false (NACK) se não houver painel no endereço.
+bool sim_oled_transacao(uint barramento, uint8_t endereco, const uint8_t *bytes, size_t quantidade)
+{
+  sim_oled_t *oled = NULL;
+  for (uint p = 0; p < total_oleds && !oled; p++)
+  {
+    if (oleds[p].barramento == barramento && oleds[p].endereco == endereco)
+      oled = &oleds[p];
+  }
+  if (!oled)
+    return false;
+  oled->usado = true;
+
+  size_t i = 0;
+  while (i < quantidade)
+  {
+    uint8_t controle = bytes[i++];
+    bool dados = controle & 0x40;
+    if (controle & 0x80)
+    {
+      if (i < quantidade)
+        dados ? receber_dado(oled, bytes[i++]) : receber_comando(oled, bytes[i++]);
+    }
+    else
+    {
+      for (; i < quantidade; i++)
+        dados ? receber_dado(oled, bytes[i]) : receber_comando(oled, bytes[i]);
+    }
+  }
+  return true;
+}
+
+// Pixel como aparece no painel, considerando a linha inicial e a inversão
+static bool pixel(const sim_oled_t *oled, uint x, uint y)
+{
+  uint linha = (y + oled->linha_inicial) % OLED_ALTURA;
+  bool aceso = oled->gddram[linha / 8][x] & (1u << (linha % 8));
+  return oled->ligado && (aceso != oled->invertido);
+}
+
+// Desenha o painel em texto, duas linhas de pixels por linha de caracteres
+static void imprimir(const sim_oled_t *oled, FILE *saida)
+{
+  static const char *const blocos[4] = {" ", "▀", "▄", "█"};
+
+  fprintf(saida, "+");
+  for (uint x = 0; x < OLED_LARGURA; x++)
+    fputc('-', saida);
+  fprintf(saida, "+ %s, contraste %u\n", oled->ligado ? "ligado" : "desligado", oled->contraste);
+
+  for (uint y = 0; y < OLED_ALTURA; y += 2)
+  {
+    fputc('|', saida);
+    for (uint x = 0; x < OLED_LARGURA; x++)
+      fputs(blocos[pixel(oled, x, y) | (pixel(oled, x, y + 1) << 1)], saida);
+    fputs("|\n", saida);
+  }
+
+  fputc('+', saida);
+  for (uint x = 0; x < OLED_LARGURA; x++)
+    fputc('-', saida);
+  fputs("+\n", saida);
+}
+
+// Desenha os painéis que já receberam dados; com mais de um, cada um leva o barramento e o endereço
+void sim_oled_imprimir(FILE *saida)
+{
+  uint usados = 0;
+  for (uint p = 0; p < total_oleds; p++)
+    usados += oleds[p].usado;
+
+  for (uint p = 0; p < total_oleds; p++)
+  {
+    if (!oleds[p].usado)
+      continue;
+    if (usados > 1)
+      fprintf(saida, "i2c%u 0x%02X\n", oleds[p].barramento, oleds[p].endereco);
+    imprimir(&oleds[p], saida);
+  }
+}
@@ -0,0 +1,750 @@
+#include "sim.h"
+#include <stdlib.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "pico/bootrom.h"
+#include "hardware/adc.h"
+#include "hardware/clocks.h"
+#include "hardware/dma.h"
+#include "hardware/gpio.h"
+#include "hardware/i2c.h"
+#include "hardware/pio.h"
+#include "hardware/pwm.h"
+
+#define SIM_CLK_SYS_HZ 125000000u
+#define SIM_CLK_48MHZ 48000000u
+#define SIM_ADC_CICLOS_MIN 96       // Uma conversão leva 96 ciclos do clock do ADC
+#define SIM_PIO_CICLOS_POR_BIT 10   // T1 + T2 + T3 do programa ws2812, o único usado pelo firmware
+#define SIM_I2C_TRANSACAO_MAX 2048
+#define SIM_SERIAL_TAMANHO 64       // Caracteres recebidos e ainda não lidos pelo firmware
+
+// Arredonda um tempo em ns para cima, em us
+static uint64_t ns_para_us(uint64_t ns)
+{
+  return (ns + 999) / 1000;
+}
+
+// ---------------------------------------------------------------------------------------
+// Clocks, stdio e bootrom
+
+uint32_t clock_get_hz(enum clock_index clk_index)
+{
+  switch (clk_index)
+  {
+  case clk_ref:
+    return 12000000;
+  case clk_usb:
+  case clk_adc:
+    return SIM_CLK_48MHZ;
+  default:
+    return SIM_CLK_SYS_HZ;
+  }
+}
+
+bool stdio_init_all(void)
+{
+  return true;
+}
+
+static char serial[SIM_SERIAL_TAMANHO];
+static size_t serial_inicio, serial_quantidade;
+
+// Caractere recebido pela serial/USB; o excedente é descartado, como num buffer cheio
+void sim_serial_entrada(char caractere)
+{
+  if (serial_quantidade < SIM_SERIAL_TAMANHO)
+    serial[(serial_inicio + serial_quantidade++) % SIM_SERIAL_TAMANHO] = caractere;
+}
+
+// Só o caso sem espera é usado pelo firmware
+int getchar_timeout_us(uint32_t timeout_us)
+{
+  (void)timeout_us;
+  if (serial_quantidade == 0)
+    return PICO_ERROR_TIMEOUT;
+  char caractere = serial[serial_inicio];
+  serial_inicio = (serial_inicio + 1) % SIM_SERIAL_TAMANHO;
+  serial_quantidade--;
+  return (unsigned char)caractere;
+}
+
+void reset_usb_boot(uint32_t usb_activity_gpio_pin_mask, uint32_t disable_interface_mask)
+{
+  (void)usb_activity_gpio_pin_mask;
+  (void)disable_interface_mask;
+  sim_parar("reset_usb_boot");
+}
+
+// ---------------------------------------------------------------------------------------
+// GPIO
+
+typedef struct
+{
+  enum gpio_function funcao;
+  bool saida;
+  bool valor;          // Nível escrito pelo firmware
+  bool pull_up, pull_down;
+  bool externo;        // O roteiro está impondo um nível ao pino
+  bool nivel_externo;
+  uint32_t mascara_irq;
+} sim_pino_t;
+
+static sim_pino_t pinos[SIM_NUM_GPIO];
+static gpio_irq_callback_t callback_gpio;
+
+static bool nivel_pino(uint gpio)
+{
+  const sim_pino_t *pino = &pinos[gpio];
+  if (pino->saida)
+    return pino->valor;
+  if (pino->externo)
+    return pino->nivel_externo;
+  return pino->pull_up;
+}
+
+// Gera a interrupção de borda se o nível do pino mudou e ela estiver habilitada
+static void conferir_borda(uint gpio, bool antes)
+{
+  bool depois = nivel_pino(gpio);
+  if (antes == depois)
+    return;
+  uint32_t evento = depois ? GPIO_IRQ_EDGE_RISE : GPIO_IRQ_EDGE_FALL;
+  if ((pinos[gpio].mascara_irq & evento) && callback_gpio)
+  {
+    sim_contadores.gpio_interrupcoes++;
+    callback_gpio(gpio, evento);
+    sim_sinalizar_interrupcao();
+  }
+}
+
+void gpio_init(uint gpio)
+{
+  pinos[gpio].funcao = GPIO_FUNC_SIO;
+  pinos[gpio].saida = false;
+  pinos[gpio].valor = false;
+}
+
+void gpio_set_dir(uint gpio, bool out)
+{
+  pinos[gpio].saida = out;
+}
+
+void gpio_set_function(uint gpio, enum gpio_function fn)
+{
+  pinos[gpio].funcao = fn;
+}
+
+void gpio_pull_up(uint gpio)
+{
+  bool antes = nivel_pino(gpio);
+  pinos[gpio].pull_up = true;
+  pinos[gpio].pull_down = false;
+  conferir_borda(gpio, antes);
+}
+
+void gpio_pull_down(uint gpio)
+{
+  bool antes = nivel_pino(gpio);
+  pinos[gpio].pull_up = false;
+  pinos[gpio].pull_down = true;
+  conferir_borda(gpio, antes);
+}
+
+void gpio_disable_pulls(uint gpio)
+{
+  bool antes = nivel_pino(gpio);
+  pinos[gpio].pull_up = false;
+  pinos[gpio].pull_down = false;
+  conferir_borda(gpio, antes);
+}
+
+bool gpio_get(uint gpio)
+{
+  return nivel_pino(gpio);
+}
+
+void gpio_put(uint gpio, bool value)
+{
+  sim_contadores.gpio_escritas++;
+  pinos[gpio].valor = value;
+}
+
+void gpio_set_irq_enabled(uint gpio, uint32_t event_mask, bool enabled)
+{
+  if (enabled)
+    pinos[gpio].mascara_irq |= event_mask;
+  else
+    pinos[gpio].mascara_irq &= ~event_mask;
+}
+
+void gpio_set_irq_enabled_with_callback(uint gpio, uint32_t event_mask, bool enabled, gpio_irq_callback_t callback)
+{
+  callback_gpio = callback;
+  gpio_set_irq_enabled(gpio, event_mask, enabled);
+}
+
+// Nível imposto a um pino de entrada pelo roteiro (botão, sensor...)
+void sim_gpio_entrada(uint pino, bool nivel)
+{
+  bool antes = nivel_pino(pino);
+  pinos[pino].externo = true;
+  pinos[pino].nivel_externo = nivel;
+  conferir_borda(pino, antes);
+}
+
+// Último nível escrito pelo firmware em um pino de saída
+bool sim_gpio_saida(uint pino)
+{
+  return pinos[pino].saida && pinos[pino].valor;
+}
+
+// ---------------------------------------------------------------------------------------
+// I2C
+
+static i2c_hw_t i2c0_hw = {.status = I2C_IC_STATUS_TFE_BITS};
+static i2c_hw_t i2c1_hw = {.status = I2C_IC_STATUS_TFE_BITS};
+i2c_inst_t sim_i2c0_inst = {&i2c0_hw, 100000, false};
+i2c_inst_t sim_i2c1_inst = {&i2c1_hw, 100000, false};
+
+uint i2c_init(i2c_inst_t *i2c, uint baudrate)
+{
+  i2c->baudrate = baudrate;
+  i2c->hw->enable = 1;
+  return baudrate;
+}
+
+// Entrega uma transação ao dispositivo no endereço e retorna o tempo de barramento em ns:
+// start + (endereço + dados) * 9 bits (com o ACK) + stop
+static uint64_t i2c_transacao(i2c_inst_t *i2c, uint8_t endereco, const uint8_t *bytes, size_t quantidade)
+{
+  uint64_t bits = 2 + 9 * (uint64_t)(quantidade + 1);
+  uint64_t tempo_ns = bits * 1000000000ull / i2c->baudrate;
+
+  sim_contadores.i2c_transacoes++;
+  sim_contadores.i2c_bytes += quantidade + 1;
+  sim_contadores.i2c_tempo_ns += tempo_ns;
+
+  i2c->nack = !sim_oled_transacao(i2c_hw_index(i2c), endereco, bytes, quantidade);
+  return tempo_ns;
+}
+
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop)
+{
+  (void)nostop;
+  uint64_t tempo_ns = i2c_transacao(i2c, addr, src, len);
+  sim_ceder_ate(sim_agora_us() + ns_para_us(tempo_ns));
+  return i2c->nack ? PICO_ERROR_GENERIC : (int)len;
+}
+
+// ---------------------------------------------------------------------------------------
+// ADC
+
+adc_hw_t sim_adc_hw;
+
+static struct
+{
+  bool rodando;
+  bool fifo;
+  bool dreq;
+  uint canal;
+  uint mascara_round_robin;
+  float divisor;
+  uint64_t proxima_ns; // Instante da próxima conversão em modo contínuo
+  uint16_t valores[SIM_NUM_ADC];
+} adc = {.valores = {2048, 2048, 2048, 2048, 2048}};
+
+static void dma_receber_adc(uint16_t amostra);
+
+static uint64_t adc_intervalo_ns(void)
+{
+  float ciclos = adc.divisor + 1;
+  if (ciclos < SIM_ADC_CICLOS_MIN)
+    ciclos = SIM_ADC_CICLOS_MIN;
+  return (uint64_t)(ciclos * 1e9f / SIM_CLK_48MHZ);
+}
+
+// Faz uma conversão no canal atual e passa ao próximo canal do round-robin
+static uint16_t adc_converter(void)
+{
+  uint16_t amostra = adc.valores[adc.canal];
+  sim_contadores.adc_amostras++;
+  adc_hw->result = amostra;
+
+  if (adc.mascara_round_robin)
+  {
+    do
+    {
+      adc.canal = (adc.canal + 1) % SIM_NUM_ADC;
+    } while (!(adc.mascara_round_robin & (1u << adc.canal)));
+  }
+  return amostra;
+}
+
+void adc_init(void)
+{
+  adc.rodando = false;
+  adc.canal = 0;
+  adc.mascara_round_robin = 0;
+}
+
+void adc_gpio_init(uint gpio)
+{
+  gpio_set_function(gpio, GPIO_FUNC_NULL);
+}
+
+void adc_select_input(uint input)
+{
+  adc.canal = input;
+}
+
+uint16_t adc_read(void)
+{
+  return adc_converter();
+}
+
+void adc_set_round_robin(uint input_mask)
+{
+  adc.mascara_round_robin = input_mask;
+}
+
+void adc_fifo_setup(bool en, bool dreq_en, uint16_t dreq_thresh, bool err_in_fifo, bool byte_shift)
+{
+  (void)dreq_thresh;
+  (void)err_in_fifo;
+  (void)byte_shift;
+  adc.fifo = en;
+  adc.dreq = dreq_en;
+}
+
+void adc_set_clkdiv(float clkdiv)
+{
+  adc.divisor = clkdiv;
+}
+
+void adc_run(bool run)
+{
+  adc.rodando = run;
+  adc.proxima_ns = sim_agora_us() * 1000 + adc_intervalo_ns();
+}
+
+// Valor que o roteiro atribui a um canal do ADC (0-4095)
+void sim_adc_definir(uint canal, uint16_t valor)
+{
+  adc.valores[canal] = valor;
+}
+
+// ---------------------------------------------------------------------------------------
+// PWM
+
+void pwm_set_clkdiv(uint slice_num, float divider)
+{
+  (void)slice_num;
+  (void)divider;
+  sim_contadores.pwm_alteracoes++;
+}
+
+void pwm_set_wrap(uint slice_num, uint16_t wrap)
+{
+  (void)slice_num;
+  (void)wrap;
+  sim_contadores.pwm_alteracoes++;
+}
+
+void pwm_set_chan_level(uint slice_num, uint chan, uint16_t level)
+{
+  (void)slice_num;
+  (void)chan;
+  (void)level;
+  sim_contadores.pwm_alteracoes++;
+}
+
+void pwm_set_gpio_level(uint gpio, uint16_t level)
+{
+  (void)gpio;
+  (void)level;
+  sim_contadores.pwm_alteracoes++;
+}
+
+void pwm_set_enabled(uint slice_num, bool enabled)
+{
+  (void)slice_num;
+  (void)enabled;
+  sim_contadores.pwm_alteracoes++;
+}
+
+// ---------------------------------------------------------------------------------------
+// PIO
+
+pio_hw_t sim_pio0_hw, sim_pio1_hw;
+
+static pio_sm_config configuracoes_sm[2][4];
+
+static pio_sm_config *configuracao_sm(PIO pio, uint sm)
+{
+  return &configuracoes_sm[pio == pio0 ? 0 : 1][sm];
+}
+
+// Tempo que a máquina de estados leva para deslocar uma palavra, em ns
+static uint64_t pio_tempo_palavra_ns(PIO pio, uint sm)
+{
+  const pio_sm_config *c = configuracao_sm(pio, sm);
+  uint bits = c->bits_por_palavra ? c->bits_por_palavra : 32;
+  return (uint64_t)(bits * SIM_PIO_CICLOS_POR_BIT * c->clkdiv * 1e9f / SIM_CLK_SYS_HZ);
+}
+
+uint pio_add_program(PIO pio, const struct pio_program *program)
+{
+  (void)pio;
+  (void)program;
+  return 0;
+}
+
+void pio_gpio_init(PIO pio, uint pin)
+{
+  gpio_set_function(pin, pio == pio0 ? GPIO_FUNC_PIO0 : GPIO_FUNC_PIO1);
+}
+
+int pio_sm_set_consecutive_pindirs(PIO pio, uint sm, uint pin_base, uint pin_count, bool is_out)
+{
+  (void)pio;
+  (void)sm;
+  for (uint i = 0; i < pin_count; i++)
+    pinos[pin_base + i].saida = is_out;
+  return PICO_OK;
+}
+
+int pio_sm_init(PIO pio, uint sm, uint initial_pc, const pio_sm_config *config)
+{
+  (void)initial_pc;
+  *configuracao_sm(pio, sm) = *config;
+  return PICO_OK;
+}
+
+void pio_sm_set_enabled(PIO pio, uint sm, bool enabled)
+{
+  (void)pio;
+  (void)sm;
+  (void)enabled;
+}
+
+void pio_sm_put_blocking(PIO pio, uint sm, uint32_t data)
+{
+  pio->txf[sm] = data;
+  uint64_t tempo_ns = pio_tempo_palavra_ns(pio, sm);
+  sim_contadores.pio_palavras++;
+  sim_contadores.pio_tempo_ns += tempo_ns;
+  sim_ceder_ate(sim_agora_us() + ns_para_us(tempo_ns));
+}
+
+// ---------------------------------------------------------------------------------------
+// DMA
+
+typedef struct
+{
+  bool reservado;
+  bool ocupado;
+  uint64_t fim_us; // Fim de uma transferência com ritmo do periférico (I2C ou PIO)
+  uint32_t recarga; // Como no RP2040, cada disparo recomeça a contagem com este valor
+  dma_channel_config config;
+} sim_canal_t;
+
+static sim_canal_t canais[NUM_DMA_CHANNELS];
+static dma_channel_hw_t canais_hw[NUM_DMA_CHANNELS];
+
+static void dma_iniciar(uint canal);
+
+static uint32_t dma_ler(uintptr_t endereco, enum dma_channel_transfer_size tamanho)
+{
+  switch (tamanho)
+  {
+  case DMA_SIZE_8:
+    return *(const volatile uint8_t *)endereco;
+  case DMA_SIZE_16:
+    return *(const volatile uint16_t *)endereco;
+  default:
+    return *(const volatile uint32_t *)endereco;
+  }
+}
+
+static void dma_escrever(uintptr_t endereco, enum dma_channel_transfer_size tamanho, uint32_t valor)
+{
+  switch (tamanho)
+  {
+  case DMA_SIZE_8:
+    *(volatile uint8_t *)endereco = (uint8_t)valor;
+    break;
+  case DMA_SIZE_16:
+    *(volatile uint16_t *)endereco = (uint16_t)valor;
+    break;
+  default:
+    *(volatile uint32_t *)endereco = valor;
+    break;
+  }
+
+  // Escrever no registrador de disparo de outro canal o reprograma e dispara
+  for (uint i = 0; i < NUM_DMA_CHANNELS; i++)
+  {
+    if (endereco == (uintptr_t)&canais_hw[i].al1_transfer_count_trig)
+    {
+      canais[i].recarga = valor;
+      dma_iniciar(i);
+    }
+  }
+}
+
+// Avança um endereço após uma transferência, respeitando o modo de anel
+static uintptr_t dma_avancar(uintptr_t endereco, const dma_channel_config *c, bool escrita)
+{
+  bool incrementar = escrita ? c->incrementar_escrita : c->incrementar_leitura;
+  if (!incrementar)
+    return endereco;
+  uintptr_t proximo = endereco + (1u << c->tamanho);
+  if (c->anel_bits && c->anel_na_escrita == escrita)
+  {
+    uintptr_t mascara = ((uintptr_t)1 << c->anel_bits) - 1;
+    proximo = (endereco & ~mascara) | (proximo & mascara);
+  }
+  return proximo;
+}
+
+// Fim de uma transferência: libera o canal e dispara o canal encadeado
+static void dma_concluir(uint canal)
+{
+  canais[canal].ocupado = false;
+  canais_hw[canal].transfer_count = 0;
+  if (canais[canal].config.encadear != canal)
+    dma_iniciar(canais[canal].config.encadear);
+}
+
+// Transferência para o I2C: o primeiro byte de cada transação vai para o endereço em IC_TAR
+// e o bit STOP de cada palavra encerra a transação
+static uint64_t dma_para_i2c(i2c_inst_t *i2c, uint canal)
+{
+  static uint8_t transacao[SIM_I2C_TRANSACAO_MAX];
+  size_t quantidade = 0;
+  uint64_t tempo_ns = 0;
+  dma_channel_hw_t *hw = &canais_hw[canal];
+  const dma_channel_config *c = &canais[canal].config;
+
+  for (; hw->transfer_count; hw->transfer_count--)
+  {
+    uint32_t palavra = dma_ler(hw->read_addr, c->tamanho);
+    hw->read_addr = dma_avancar(hw->read_addr, c, false);
+    if (quantidade < SIM_I2C_TRANSACAO_MAX)
+      transacao[quantidade++] = (uint8_t)palavra;
+    if (palavra & I2C_IC_DATA_CMD_STOP_BITS)
+    {
+      tempo_ns += i2c_transacao(i2c, (uint8_t)i2c->hw->tar, transacao, quantidade);
+      quantidade = 0;
+    }
+  }
+  if (quantidade)
+    tempo_ns += i2c_transacao(i2c, (uint8_t)i2c->hw->tar, transacao, quantidade);
+  return tempo_ns;
+}
+
+// Transferência para a FIFO de uma máquina de estados do PIO
+static uint64_t dma_para_pio(PIO pio, uint sm, uint canal)
+{
+  dma_channel_hw_t *hw = &canais_hw[canal];
+  const dma_channel_config *c = &canais[canal].config;
+  uint64_t tempo_ns = 0;
+
+  for (; hw->transfer_count; hw->transfer_count--)
+  {
+    pio->txf[sm] = dma_ler(hw->read_addr, c->tamanho);
+    hw->read_addr = dma_avancar(hw->read_addr, c, false);
+    sim_contadores.pio_palavras++;
+    tempo_ns += pio_tempo_palavra_ns(pio, sm);
+  }
+  sim_contadores.pio_tempo_ns += tempo_ns;
+  return tempo_ns;
+}
+
+// Conversão do ADC entregue ao canal que espera pelo DREQ do ADC
+static void dma_receber_adc(uint16_t amostra)
+{
+  for (uint i = 0; i < NUM_DMA_CHANNELS; i++)
+  {
+    sim_canal_t *canal = &canais[i];
+    if (!canal->ocupado || canal->config.dreq != DREQ_ADC)
+      continue;
+    dma_channel_hw_t *hw = &canais_hw[i];
+    dma_escrever(hw->write_addr, canal->config.tamanho, amostra);
+    hw->write_addr = dma_avancar(hw->write_addr, &canal->config, true);
+    if (--hw->transfer_count == 0)
+      dma_concluir(i);
+    return;
+  }
+}
+
+static void dma_iniciar(uint canal)
+{
+  sim_canal_t *c = &canais[canal];
+  dma_channel_hw_t *hw = &canais_hw[canal];
+  uint dreq = c->config.dreq;
+
+  sim_contadores.dma_disparos++;
+  c->ocupado = true;
+  hw->transfer_count = c->recarga;
+
+  if (dreq == DREQ_I2C0_TX || dreq == DREQ_I2C1_TX)
+  {
+    uint64_t tempo_ns = dma_para_i2c(dreq == DREQ_I2C0_TX ? i2c0 : i2c1, canal);
+    c->fim_us = sim_agora_us() + ns_para_us(tempo_ns);
+  }
+  else if (dreq < 16 && !(dreq & 4))
+  {
+    uint64_t tempo_ns = dma_para_pio(dreq < 8 ? pio0 : pio1, dreq & 3, canal);
+    c->fim_us = sim_agora_us() + ns_para_us(tempo_ns);
+  }
+  else if (dreq == DREQ_ADC)
+  {
+    c->fim_us = SIM_NUNCA; // Termina quando o ADC tiver entregue todas as amostras
+  }
+  else
+  {
+    // Sem DREQ: cópia imediata
+    while (hw->transfer_count)
+    {
+      uint32_t valor = dma_ler(hw->read_addr, c->config.tamanho);
+      hw->read_addr = dma_avancar(hw->read_addr, &c->config, false);
+      uintptr_t destino = hw->write_addr;
+      hw->write_addr = dma_avancar(hw->write_addr, &c->config, true);
+      hw->transfer_count--;
+      dma_escrever(destino, c->config.tamanho, valor);
+    }
+    dma_concluir(canal);
+  }
+}
+
+int dma_claim_unused_channel(bool required)
+{
+  for (uint i = 0; i < NUM_DMA_CHANNELS; i++)
+  {
+    if (!canais[i].reservado)
+    {
+      canais[i].reservado = true;
+      return (int)i;
+    }
+  }
+  if (required)
+  {
+    fprintf(stderr, "sim: nenhum canal de DMA livre\n");
+    exit(1);
+  }
+  return -1;
+}
+
+void dma_channel_unclaim(uint channel)
+{
+  canais[channel].reservado = false;
+}
+
+dma_channel_hw_t *dma_channel_hw_addr(uint channel)
+{
+  return &canais_hw[channel];
+}
+
+dma_channel_config dma_channel_get_default_config(uint channel)
+{
+  dma_channel_config c = {DMA_SIZE_32, true, false, false, 0, DREQ_FORCE, (uint8_t)channel};
+  return c;
+}
+
+void channel_config_set_transfer_data_size(dma_channel_config *c, enum dma_channel_transfer_size size)
+{
+  c->tamanho = size;
+}
+
+void channel_config_set_read_increment(dma_channel_config *c, bool incr)
+{
+  c->incrementar_leitura = incr;
+}
+
+void channel_config_set_write_increment(dma_channel_config *c, bool incr)
+{
+  c->incrementar_escrita = incr;
+}
+
+void channel_config_set_dreq(dma_channel_config *c, uint dreq)
+{
+  c->dreq = (uint8_t)dreq;
+}
+
+void channel_config_set_ring(dma_channel_config *c, bool write, uint size_bits)
+{
+  c->anel_na_escrita = write;
+  c->anel_bits = (uint8_t)size_bits;
+}
+
+void channel_config_set_chain_to(dma_channel_config *c, uint chain_to)
+{
+  c->encadear = (uint8_t)chain_to;
+}
+
+void dma_channel_configure(uint channel, const dma_channel_config *config, volatile void *write_addr,
+                           const volatile void *read_addr, uint transfer_count, bool trigger)
+{
+  canais[channel].config = *config;
+  canais_hw[channel].write_addr = (uintptr_t)write_addr;
+  canais_hw[channel].read_addr = (uintptr_t)read_addr;
+  canais_hw[channel].transfer_count = transfer_count;
+  canais[channel].recarga = transfer_count;
+  if (trigger)
+    dma_iniciar(channel);
+}
+
+void dma_channel_set_read_addr(uint channel, const volatile void *read_addr, bool trigger)
+{
+  canais_hw[channel].read_addr = (uintptr_t)read_addr;
+  if (trigger)
+    dma_iniciar(channel);
+}
+
+void dma_channel_start(uint channel)
+{
+  dma_iniciar(channel);
+}
+
+// Enquanto o periférico ainda consome a transferência, o núcleo que consulta fica parado
+// até o fim dela: é o mesmo tempo que ele gastaria consultando em laço no RP2040
+bool dma_channel_is_busy(uint channel)
+{
+  sim_canal_t *c = &canais[channel];
+  if (c->ocupado && c->fim_us != SIM_NUNCA && c->fim_us <= sim_agora_us())
+    dma_concluir(channel);
+  if (c->ocupado && c->fim_us != SIM_NUNCA)
+    sim_ceder_ate(c->fim_us);
+  return c->ocupado;
+}
+
+void dma_channel_abort(uint channel)
+{
+  canais[channel].ocupado = false;
+}
+
+void dma_channel_wait_for_finish_blocking(uint channel)
+{
+  while (dma_channel_is_busy(channel))
+    tight_loop_contents();
+}
+
+// ---------------------------------------------------------------------------------------
+
+// Produz as conversões do ADC em modo contínuo até o instante indicado
+void sim_perifericos_avancar(uint64_t ate_us)
+{
+  if (!adc.rodando)
+    return;
+  uint64_t intervalo_ns = adc_intervalo_ns();
+  while (adc.proxima_ns <= ate_us * 1000)
+  {
+    uint16_t amostra = adc_converter();
+    if (adc.fifo && adc.dreq)
+      dma_receber_adc(amostra);
+    else
+      adc_hw->fifo = amostra;
+    adc.proxima_ns += intervalo_ns;
+  }
+}